@@ -1015,6 +1015,11 @@
  * See https://github.com/synthetos/TinyG/wiki/Jerk-Controlled-Motion-Explained
  */
 #define S_CURVE_ACCELERATION
+#if ENABLED(S_CURVE_ACCELERATION)
+  // Plan the Bézier speed ramps so their peak jerk stays below this (mm/s³).
+  // Mostly lengthens the small speed changes between short segments.
+  #define S_CURVE_JERK_LIMIT 100000
+#endif
 
 //===========================================================================
 //============================= Z Probe Options =============================
@@ -2668,6 +2673,7 @@
 #define GEEETECH_A30T_TFT
 #if ENABLED(GEEETECH_A30T_TFT)
   #define LCD_SERIAL_PORT 2 // Default is 2 for Geeetech A30T
+  #define DISPLAY_BUFSIZE 4 // Commands from the display waiting for room in the command queue
 #endif
 
 //
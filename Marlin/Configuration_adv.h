@@ -1158,6 +1158,54 @@
  */
 //#define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Adaptive Multi-Stepping measures how long the Stepper ISR really takes, with the cycle
+ * counter, and takes more steps per ISR (or oversamples less with ADAPTIVE_STEP_SMOOTHING)
+ * only when the ISR would otherwise use more than STEPPER_ISR_BUDGET of the CPU. This
+ * replaces the fixed cycle estimates, which can't know about mixing or dual Z steppers.
+ * Requires a Cortex-M3 or better (e.g., STM32F1) or LINUX.
+ */
+//#define ADAPTIVE_MULTI_STEPPING
+#if ENABLED(ADAPTIVE_MULTI_STEPPING)
+  #define STEPPER_ISR_BUDGET 70   // (%) Share of the CPU the Stepper ISR may use
+#endif
+
+/**
+ * Input Shaping
+ *
+ * Split every X and/or Y step into two or three partial steps, spread over about
+ * half a period of the axis' dominant resonance, so the ringing started by one is
+ * cancelled by the next. Allows higher accelerations without visible ringing.
+ *
+ * Shaper types:
+ *   0 : ZV  - Zero Vibration. Shortest delay, needs an accurately measured frequency.
+ *   1 : ZVD - Zero Vibration and Derivative. Tolerates frequency errors, twice the delay.
+ *   2 : MZV - Modified ZV. A compromise between the two.
+ *
+ * The step buffer uses a lot of SRAM. Its size is computed from the lowest shaping
+ * frequency and the highest step rate of the shaped axes (DEFAULT_MAX_FEEDRATE *
+ * DEFAULT_AXIS_STEPS_PER_UNIT). Override these with SHAPING_MIN_FREQ and
+ * SHAPING_MAX_STEPRATE. Steps that don't fit in the buffer are not shaped.
+ *
+ * Tune with M593 X Y T<type> F<frequency> D<damping>. F0 disables shaping.
+ */
+//#define INPUT_SHAPING_X
+//#define INPUT_SHAPING_Y
+#if EITHER(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+  #if ENABLED(INPUT_SHAPING_X)
+    #define SHAPING_TYPE_X  0           // Shaper type (0:ZV 1:ZVD 2:MZV)
+    #define SHAPING_FREQ_X  40          // (Hz) Dominant resonant frequency of the X axis
+    #define SHAPING_ZETA_X  0.10f       // Damping ratio of the X axis (0.0 = none ... 1.0 = critical)
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    #define SHAPING_TYPE_Y  0           // Shaper type (0:ZV 1:ZVD 2:MZV)
+    #define SHAPING_FREQ_Y  30          // (Hz) Dominant resonant frequency of the Y axis
+    #define SHAPING_ZETA_Y  0.10f       // Damping ratio of the Y axis (0.0 = none ... 1.0 = critical)
+  #endif
+  //#define SHAPING_MIN_FREQ      20    // (Hz) Lowest frequency M593 will accept. Default: the lowest SHAPING_FREQ.
+  //#define SHAPING_MAX_STEPRATE  10000 // (steps/s) Highest step rate of a shaped axis. Sizes the step buffer.
+#endif
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -1939,15 +1987,17 @@
  * If this algorithm produces a higher speed offset than the extruder can handle (compared to E jerk)
  * print acceleration will be reduced during the affected moves to keep within the limit.
  *
+ * The advance follows the actual speed of each move, so it works with S_CURVE_ACCELERATION.
+ * With a MIXING_EXTRUDER the advance steps are shared out by the current mix.
+ *
  * See https://marlinfw.org/docs/features/lin_advance.html for full instructions.
  */
-//#define LIN_ADVANCE
+#define LIN_ADVANCE
 #if ENABLED(LIN_ADVANCE)
   //#define EXTRA_LIN_ADVANCE_K // Enable for second linear advance constants
-  #define LIN_ADVANCE_K 0.22    // Unit: mm compression per 1mm/s extruder speed
+  #define LIN_ADVANCE_K 0       // Unit: mm compression per 1mm/s extruder speed. Calibrate, then set with M900 K.
   //#define LA_DEBUG            // If enabled, this will generate debug information output over USB.
-  //#define EXPERIMENTAL_SCURVE // Enable this option to permit S-Curve Acceleration
-  //#define ALLOW_LOW_EJERK     // Allow a DEFAULT_EJERK value of <10. Recommended for direct drive hotends.
+  #define ALLOW_LOW_EJERK       // Allow a DEFAULT_EJERK value of <10. Recommended for direct drive hotends.
 #endif
 
 // @section leveling
@@ -2106,6 +2156,24 @@
   #define N_ARC_CORRECTION       25   // Number of interpolated segments between corrections
   #define ARC_P_CIRCLES               // Enable the 'P' parameter to specify complete circles
   //#define SF_ARC_FIX                // Enable only if using SkeinForge with "Arc Point" fillet procedure
+
+  /**
+   * Arc Fitting
+   *
+   * Replace runs of short G1 moves along a circle, as sliced curves are made
+   * of, with one arc traced as above. Fewer, longer segments need less planner
+   * work per mm. Moves are held until the run ends, at any other command, or
+   * when the planner buffer is running low. Not used with SEGMENT_MERGE.
+   */
+  //#define ARC_FITTING
+  #if ENABLED(ARC_FITTING)
+    #define ARC_FIT_TOLERANCE         0.01 // (mm) Largest distance of a point from the fitted arc
+    #define ARC_FIT_MAX_LENGTH        2.0  // (mm) Moves longer than this are planned as usual
+    #define ARC_FIT_MAX_RADIUS      200.0  // (mm) Flatter curves are planned as lines
+    #define ARC_FIT_MIN_POINTS        4    // Fewest moves to replace with an arc
+    #define ARC_FIT_MAX_POINTS       32    // Most moves to replace with one arc
+    #define ARC_FIT_E_RATIO_TOLERANCE 0.05 // Largest relative change in extrusion per mm
+  #endif
 #endif
 
 // G5 Bézier Curve Support with XYZE destination and IJPQ offsets
@@ -2141,6 +2209,23 @@
 // Moves (or segments) with fewer steps than this will be joined with the next move
 #define MIN_STEPS_PER_SEGMENT 6
 
+/**
+ * Segment Merge
+ *
+ * Join runs of short G1 moves that lie on a straight line into a single move,
+ * as sliced curves and some CAM output produce. Fewer, longer moves fill the
+ * planner buffer further ahead and need less planner work per mm.
+ * Held moves are planned when a move doesn't fit on the line, at any other
+ * command, or when the planner buffer is running low.
+ */
+//#define SEGMENT_MERGE
+#if ENABLED(SEGMENT_MERGE)
+  #define SEGMENT_MERGE_TOLERANCE         0.01 // (mm) Largest deviation of a joined point from the line
+  #define SEGMENT_MERGE_MAX_LENGTH        2.0  // (mm) Moves longer than this are planned as usual
+  #define SEGMENT_MERGE_MAX_POINTS       16    // Most moves to join into one
+  #define SEGMENT_MERGE_E_RATIO_TOLERANCE 0.05 // Largest relative change in extrusion per mm
+#endif
+
 /**
  * Minimum delay before and after setting the stepper DIR (in ns)
  *     0 : No delay (Expect at least 10µS since one Stepper ISR must transpire)
@@ -2184,6 +2269,15 @@
  */
 //#define MAXIMUM_STEPPER_RATE 250000
 
+/**
+ * Get the step interval from a table instead of dividing STEPPER_TIMER_RATE by
+ * the step rate in every stepper ISR. The table is built at compile time for the
+ * configured timer rate and adds 1K of flash. Faster on 32-bit MCUs without a
+ * hardware divider. Cortex-M3/M4 (STM32F1/F4, LPC17xx) have one, so measure
+ * before enabling it there. 8-bit AVR always uses its own tables.
+ */
+//#define STEP_INTERVAL_TABLE
+
 // @section temperature
 
 // Control heater 0 and heater 1 in parallel.
@@ -3731,6 +3825,16 @@
 
 #if ENABLED(FASTER_GCODE_PARSER)
   //#define GCODE_QUOTED_STRINGS  // Support for quoted string parameters
+
+  /**
+   * Parse plain G0-G3 moves from the SD card (and other sources needing no "ok")
+   * as they are queued, and keep several of them in each of the BUFSIZE slots.
+   * More moves fit in the queue and their values aren't converted again later.
+   */
+  //#define PREPARSED_GCODE_QUEUE
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    #define PREPARSED_MAX_PARAMS 4  // Moves with more parameters are queued as text
+  #endif
 #endif
 
 // Support for MeatPack G-code compression (https://github.com/scottmudge/OctoPrint-MeatPack)
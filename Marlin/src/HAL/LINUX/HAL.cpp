@@ -23,6 +23,7 @@
 
 #include "../../inc/MarlinConfig.h"
 #include "../shared/Delay.h"
+#include "hardware/Scheduler.h"
 
 MSerialT usb_serial(TERN0(EMERGENCY_PARSER, true));
 
@@ -75,4 +76,9 @@ void HAL_pwm_init() {
 
 void HAL_reboot() { /* Reset the application state and GPIO */ }
 
+// On virtual time an idle CPU just skips ahead to the next timer event
+void HAL_idletask() {
+  if (Clock::isVirtual()) Scheduler::runNextEvent();
+}
+
 #endif // __PLAT_LINUX__
@@ -78,6 +78,9 @@ extern MSerialT usb_serial;
 
 inline void HAL_init() {}
 
+#define HAL_IDLETASK 1
+void HAL_idletask();
+
 // Utility functions
 #pragma GCC diagnostic push
 #if GCC_VERSION <= 50000
@@ -114,3 +117,6 @@ void HAL_reboot(); // Reset the application state and GPIO
 FORCE_INLINE static void DELAY_CYCLES(uint64_t x) {
   Clock::delayCycles(x);
 }
+
+// Free-running cycle count, for timing code (virtual cycles in batch mode)
+#define HAL_CYCLE_COUNT() uint32_t(Clock::ticks())
@@ -24,6 +24,7 @@
 #include <iostream>
 #include "../../inc/MarlinConfig.h"
 #include "hardware/Clock.h"
+#include "hardware/Scheduler.h"
 #include "../shared/Delay.h"
 
 // Interrupts
@@ -36,6 +37,9 @@ void _delay_ms(const int delay_ms) {
 }
 
 uint32_t millis() {
+  // Reading the clock costs 1µs of virtual time, so that timeout loops
+  // which poll millis() without calling idle() still terminate
+  if (Clock::isVirtual()) Scheduler::advance(1000);
   return (uint32_t)Clock::millis();
 }
 
@@ -0,0 +1,308 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+#include "../../module/planner.h"
+#include "../../module/motion.h"
+#include "../../module/temperature.h"
+#include "../../module/stepper.h"
+#include "../../module/step_interval_table.h"
+#include "../../gcode/parser.h"
+#include "benchmark.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+
+namespace {
+
+  typedef std::chrono::steady_clock bench_clock;
+
+  double elapsed_ns(const bench_clock::time_point start, const uint32_t count) {
+    return std::chrono::duration<double, std::nano>(bench_clock::now() - start).count() / count;
+  }
+
+  /**
+   * Planner: stream dense short segments the way arcs and small features arrive,
+   * keeping the block buffer full by consuming the oldest block like the stepper
+   * does. The same moves are planned incrementally and with a full replan of the
+   * buffer, and the resulting trapezoids must be identical.
+   */
+  struct PlannerRun {
+    double ns_per_segment, trapezoids_per_segment;
+    uint32_t plan_hash;
+  };
+
+  uint32_t hash_block(uint32_t hash, const block_t * const block) {
+    const uint32_t fields[] = { block->accelerate_until, block->decelerate_after, block->initial_rate, block->final_rate };
+    for (const uint32_t field : fields) hash = (hash ^ field) * 16777619UL;
+    return hash;
+  }
+
+  uint32_t consume_block(const uint32_t hash) {
+    const block_t * const block = planner.get_current_block();
+    if (!block) return hash;
+    const uint32_t h = hash_block(hash, block);
+    planner.release_current_block();
+    return h;
+  }
+
+  xyze_pos_t planner_segment(const xyze_pos_t &start, const uint32_t i) {
+    xyze_pos_t pos = start;
+    if ((i / 500) & 1) {
+      // A 5 mm circle in 0.5 mm chords
+      const float a = i * (2 * float(M_PI) / 64);
+      pos.x += 5 * cos(a);
+      pos.y += 5 * sin(a);
+    }
+    else {
+      // Zig-zag infill of 2 mm lines, 0.4 mm apart
+      pos.x += (i & 1) ? 2 : 0;
+      pos.y += (i % 500) * 0.2f;
+    }
+    pos.e += i * 0.02f;
+    return pos;
+  }
+
+  PlannerRun run_planner(const bool full_replan, const uint32_t segments) {
+    const xyze_pos_t start = current_position;
+    planner.init();
+    planner.set_position_mm(start);
+    planner.full_replan = full_replan;
+    planner.trapezoids_calculated = 0;
+
+    uint32_t plan_hash = 2166136261UL;
+    const bench_clock::time_point started = bench_clock::now();
+    for (uint32_t i = 0; i < segments; i++) {
+      while (!planner.moves_free()) plan_hash = consume_block(plan_hash);
+      planner.buffer_line(planner_segment(start, i), 60, active_extruder);
+    }
+    const double ns = elapsed_ns(started, segments),
+                 trapezoids = double(planner.trapezoids_calculated) / segments;
+
+    while (planner.has_blocks_queued()) plan_hash = consume_block(plan_hash);
+    planner.full_replan = false;
+    return { ns, trapezoids, plan_hash };
+  }
+
+  int benchmark_planner() {
+    constexpr uint32_t segments = 200000;
+    TERN_(PREVENT_COLD_EXTRUSION, thermalManager.allow_cold_extrude = true);
+    run_planner(false, segments / 10); // Warm up
+    const PlannerRun incremental = run_planner(false, segments),
+                     full = run_planner(true, segments);
+
+    printf("planner: %u segments, %u block buffer\n", segments, BLOCK_BUFFER_SIZE);
+    printf("  incremental  %8.1f ns/segment  %5.2f trapezoids/segment\n", incremental.ns_per_segment, incremental.trapezoids_per_segment);
+    printf("  full replan  %8.1f ns/segment  %5.2f trapezoids/segment\n", full.ns_per_segment, full.trapezoids_per_segment);
+    printf("  saved        %8.1f ns/segment (%.0f%%)\n", full.ns_per_segment - incremental.ns_per_segment,
+           100 * (1 - incremental.ns_per_segment / full.ns_per_segment));
+
+    const bool identical = incremental.plan_hash == full.plan_hash;
+    printf("  plans %s\n", identical ? "identical" : "DIFFER");
+    return identical ? 0 : 1;
+  }
+
+  /**
+   * Stepper: the step rate to timer interval conversion done for every step
+   * event. Each call takes the previous result into the next rate, so this is
+   * the latency an ISR sees, in TSC cycles where the host has one.
+   */
+  uint64_t cycle_count() {
+    #if defined(__x86_64__) || defined(__i386__)
+      return __builtin_ia32_rdtsc();
+    #else
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now().time_since_epoch()).count();
+    #endif
+  }
+
+  uint32_t divide_interval(const uint32_t step_rate) { return uint32_t(STEPPER_TIMER_RATE) / step_rate; }
+
+  volatile uint32_t interval_sink; // Keeps the timed loops from being optimized away
+
+  template<uint32_t (*INTERVAL)(const uint32_t)>
+  double interval_cycles(const uint32_t * const rates, const uint32_t count, const uint32_t rounds, uint32_t &sum) {
+    uint32_t idx = 0;
+    const uint64_t start = cycle_count();
+    for (uint32_t n = rounds * count; n--;) {
+      const uint32_t interval = INTERVAL(rates[idx]);
+      sum += interval;
+      idx = (idx + 1 + (interval & 1)) & (count - 1);
+    }
+    return double(cycle_count() - start) / (rounds * count);
+  }
+
+  int benchmark_stepper() {
+    constexpr uint32_t min_rate = 32, max_rate = MAX_STEP_ISR_FREQUENCY_1X, count = 4096, rounds = 2000;
+
+    // Accuracy over every step rate the ISR can ask for
+    double max_ticks = 0, max_ppm = 0;
+    for (uint32_t rate = 1; rate <= max_rate; ++rate) {
+      const double exact = double(STEPPER_TIMER_RATE) / rate, err = fabs(step_interval(rate) - exact);
+      if (exact < 50000) NOLESS(max_ticks, err); else NOLESS(max_ppm, err / exact * 1e6);
+    }
+
+    // Rates spread evenly on a log scale, visited in a scrambled order
+    static uint32_t rates[count];
+    for (uint32_t i = 0; i < count; ++i)
+      rates[(i * 2654435761UL) & (count - 1)] = uint32_t(min_rate * pow(double(max_rate) / min_rate, double(i) / (count - 1)));
+
+    uint32_t div_sum = 0, table_sum = 0;
+    interval_cycles<divide_interval>(rates, count, rounds / 10, div_sum); // Warm up
+    div_sum = 0;
+    const double div_cycles = interval_cycles<divide_interval>(rates, count, rounds, div_sum),
+                 table_cycles = interval_cycles<step_interval>(rates, count, rounds, table_sum);
+    interval_sink = div_sum + table_sum;
+
+    printf("stepper: step rate to interval, STEPPER_TIMER_RATE %u, rates %u-%u\n", unsigned(STEPPER_TIMER_RATE), unsigned(min_rate), unsigned(max_rate));
+    printf("  divide  %8.2f cycles/call\n", div_cycles);
+    printf("  table   %8.2f cycles/call  (%u entries, scale 2^%u)\n", table_cycles, unsigned(STEP_INTERVAL_TABLE_SIZE), unsigned(STEP_INTERVAL_SHIFT));
+    printf("  table error: %.3f ticks max below 50000 ticks, %.2f ppm max above\n", max_ticks, max_ppm);
+    printf("  calc_timer_interval uses the %s\n", TERN(STEP_INTERVAL_TABLE, "table", "divide"));
+
+    return max_ticks < 1 && max_ppm < 10 ? 0 : 1;
+  }
+
+  /**
+   * G-code numbers: parser.parse_float() against strtof(), the way value_float()
+   * used it, with any exponent cut off. Random numbers of every shape a G-code
+   * value can take must convert to the identical float, then a set of typical
+   * slicer values is timed both ways.
+   */
+  float strtof_value(char * const str) {
+    for (char *e = str; *e && *e != ' '; ++e) {
+      const char c = *e;
+      if (c == 'E' || c == 'e') {
+        *e = '\0';
+        const float ret = strtof(str, nullptr);
+        *e = c;
+        return ret;
+      }
+    }
+    return strtof(str, nullptr);
+  }
+
+  uint32_t xorshift(uint32_t &state) {
+    state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+    return state;
+  }
+
+  // A random number as it may follow a G-code parameter letter
+  void random_number(char *p, uint32_t &rnd) {
+    switch (xorshift(rnd) % 8) { case 0: *p++ = '-'; break; case 1: *p++ = '+'; break; }
+    const uint8_t int_digits = xorshift(rnd) % 7;
+    uint8_t decimals = xorshift(rnd) % 13;
+    for (uint8_t i = 0; i < int_digits; ++i) *p++ = '0' + xorshift(rnd) % 10;
+    if (!int_digits && !decimals) decimals = 1;
+    if (decimals) {
+      *p++ = '.';
+      while (decimals--) *p++ = xorshift(rnd) % 4 ? '0' + xorshift(rnd) % 10 : '0';
+    }
+    switch (xorshift(rnd) % 16) {                 // What may come after it
+      case 0: *p++ = 'E'; *p++ = '5'; break;
+      case 1: *p++ = ' '; *p++ = 'Y'; break;
+      case 2: *p++ = 'Y'; *p++ = '1'; break;
+      case 3: *p++ = '.'; *p++ = '5'; break;
+    }
+    *p = '\0';
+  }
+
+  volatile float float_sink; // Keeps the timed loops from being optimized away
+
+  template<float (*CONVERT)(char * const)>
+  double convert_ns(char (*numbers)[16], const uint32_t count, const uint32_t rounds) {
+    float sum = 0;
+    const bench_clock::time_point started = bench_clock::now();
+    for (uint32_t r = 0; r < rounds; ++r)
+      for (uint32_t i = 0; i < count; ++i) sum += CONVERT(numbers[i]);
+    const double ns = elapsed_ns(started, rounds * count);
+    float_sink = sum;
+    return ns;
+  }
+
+  int benchmark_gcode_float() {
+    constexpr uint32_t checks = 10000000, count = 4096, rounds = 500;
+
+    // Identical results for random numbers and the edge cases
+    static const char * const edges[] = {
+      "0", "-0", "+0", ".5", "-.5", "5.", "007", "1.2.3", "0x10", "1e5", "2E-3", "16777215", "16777216",
+      "16777217", "1677721.55", "0.0000000001", "0.00000000001", "123.4560000000000", "99999999999"
+    };
+    uint32_t rnd = 0x2545F491, mismatches = 0;
+    char str[40];
+    for (uint32_t n = 0; n < checks + COUNT(edges); ++n) {
+      if (n < COUNT(edges)) strcpy(str, edges[n]); else random_number(str, rnd);
+      const float fast = GCodeParser::parse_float(str), slow = strtof_value(str);
+      if (memcmp(&fast, &slow, sizeof(float))) {
+        if (++mismatches <= 10) printf("  MISMATCH \"%s\": %.9g vs. strtof %.9g\n", str, double(fast), double(slow));
+      }
+    }
+
+    // Values as slicers write them: XY with 3 decimals, E with 5, whole F
+    static char numbers[count][16];
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint32_t r = xorshift(rnd);
+      switch (i % 4) {
+        case 0: case 1: sprintf(numbers[i], "%.3f", (r % 300000) / 1000.0); break;
+        case 2: sprintf(numbers[i], "%.5f", (r % 200000) / 100000.0); break;
+        case 3: sprintf(numbers[i], "%u", unsigned(600 + r % 6000)); break;
+      }
+    }
+
+    convert_ns<strtof_value>(numbers, count, rounds / 10); // Warm up
+    const double strtof_ns = convert_ns<strtof_value>(numbers, count, rounds),
+                 fast_ns = convert_ns<GCodeParser::parse_float>(numbers, count, rounds);
+
+    printf("gcode_float: %u random numbers checked, %u mismatches\n", unsigned(checks + COUNT(edges)), unsigned(mismatches));
+    printf("  strtof       %8.1f ns/number\n", strtof_ns);
+    printf("  parse_float  %8.1f ns/number  (%.1fx)\n", fast_ns, strtof_ns / fast_ns);
+
+    return mismatches ? 1 : 0;
+  }
+
+  struct Benchmark {
+    const char *name, *description;
+    int (*run)();
+  };
+
+  const Benchmark benchmarks[] = {
+    { "planner", "Incremental vs. full planner recalculation per buffered segment", benchmark_planner },
+    { "stepper", "Step interval from a table vs. a divide, in cycles per call", benchmark_stepper },
+    { "gcode_float", "G-code number conversion vs. strtof, checked for identical results", benchmark_gcode_float }
+  };
+
+} // namespace
+
+int run_benchmark(const char *name) {
+  DISABLE_STEPPER_DRIVER_INTERRUPT();
+  for (const Benchmark &b : benchmarks)
+    if (!strcmp(name, b.name)) return b.run();
+
+  fprintf(stderr, "Benchmarks:\n");
+  for (const Benchmark &b : benchmarks)
+    fprintf(stderr, "  %-12s %s\n", b.name, b.description);
+  return strcmp(name, "list") ? 1 : 0;
+}
+
+#endif // __PLAT_LINUX__
@@ -21,20 +21,10 @@
  */
 #pragma once
 
-#include <mutex>
-#include <list>
-#include <fstream>
-#include "Gpio.h"
-
-class IOLoggerCSV: public IOLogger {
-public:
-  IOLoggerCSV(std::string filename);
-  virtual ~IOLoggerCSV();
-  void flush();
-  void log(GpioEvent ev);
+/**
+ * Host benchmarks of firmware hot paths. They run after setup() instead of
+ * the main loop, with the stepper interrupt stopped and time standing still.
+ */
 
-private:
-  std::ofstream file;
-  std::list<GpioEvent> events;
-  std::mutex vector_lock;
-};
+// Run the named benchmark, or list them all for an unknown name. Return the exit status.
+int run_benchmark(const char *name);
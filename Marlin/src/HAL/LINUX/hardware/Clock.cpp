@@ -23,9 +23,16 @@
 
 #include "../../../inc/MarlinConfig.h"
 #include "Clock.h"
+#include "Scheduler.h"
 
 std::chrono::nanoseconds Clock::startup = std::chrono::high_resolution_clock::now().time_since_epoch();
 uint32_t Clock::frequency = F_CPU;
 double Clock::time_multiplier = 1.0;
+bool Clock::virtual_time = false;
+uint64_t Clock::virtual_nanos = 0;
+
+void Clock::delayVirtual(uint64_t ns) {
+  Scheduler::advance(ns);
+}
 
 #endif // __PLAT_LINUX__
@@ -27,7 +27,7 @@
 class Clock {
 public:
   static uint64_t ticks(uint32_t frequency = Clock::frequency) {
-    return (Clock::nanos() - Clock::startup.count()) / (1000000000ULL / frequency);
+    return Clock::nanos() / (1000000000ULL / frequency);
   }
 
   static uint64_t nanosToTicks(uint64_t ns, uint32_t frequency = Clock::frequency) {
@@ -45,6 +45,7 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
+    if (Clock::virtual_time) return Clock::virtual_nanos;
     auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
     return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
   }
@@ -62,18 +63,22 @@ public:
   }
 
   static void delayCycles(uint64_t cycles) {
+    if (Clock::virtual_time) return Clock::delayVirtual((1000000000ULL / frequency) * cycles);
     std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
   }
 
   static void delayMicros(uint64_t micros) {
+    if (Clock::virtual_time) return Clock::delayVirtual(micros * 1000ULL);
     std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
   }
 
   static void delayMillis(uint64_t millis) {
+    if (Clock::virtual_time) return Clock::delayVirtual(millis * 1000000ULL);
     std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
   }
 
   static void delaySeconds(double secs) {
+    if (Clock::virtual_time) return Clock::delayVirtual(secs * 1000000000.0);
     std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
   }
 
@@ -82,8 +87,26 @@ public:
     Clock::time_multiplier = tm;
   }
 
+  // Virtual time is only advanced by the Scheduler, which runs the timer
+  // callbacks synchronously as their events come due. Must be selected before
+  // any Timer is initialised.
+  static void setVirtualTime(bool enable) {
+    Clock::virtual_time = enable;
+    Clock::virtual_nanos = 0;
+  }
+
+  static bool isVirtual() {
+    return Clock::virtual_time;
+  }
+
 private:
+  friend class Scheduler;
+
+  static void delayVirtual(uint64_t ns);
+
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
+  static bool virtual_time;
+  static uint64_t virtual_nanos;
 };
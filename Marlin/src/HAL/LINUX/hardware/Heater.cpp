@@ -23,38 +23,93 @@
 
 #include "Clock.h"
 #include <stdio.h>
+#include <math.h>
 #include "../../../inc/MarlinConfig.h"
 
 #include "Heater.h"
 
-Heater::Heater(pin_t heater, pin_t adc) {
-  heater_state = 0;
-  room_temp_raw = 150;
-  last = Clock::micros();
+// Integration step of the thermal model
+#define HEATER_UPDATE_NS 1000000
+
+void PwmInput::attach(pin_t p, Peripheral *owner, uint64_t now) {
+  pin = p;
+  last_change = now;
+  Gpio::attachPeripheral(pin, owner);
+}
+
+void PwmInput::change(uint64_t timestamp) {
+  on_time += (timestamp - last_change) * level;
+  last_change = timestamp;
+  // analogWrite stores the duty (0-255) in the pin, soft PWM toggles it
+  const uint16_t value = Gpio::pin_map[pin].value;
+  level = value > 1 ? value / 255.0f : value;
+}
+
+float PwmInput::duty(uint64_t from, uint64_t now) {
+  if (pin == P_NC || now <= from) return 0;
+  on_time += (now - last_change) * level;
+  last_change = now;
+  const float result = on_time / (now - from);
+  on_time = 0;
+  return result;
+}
+
+Heater::Heater(pin_t heater, pin_t adc, const ThermalModel &model, const temp_entry_t *table, uint8_t table_len, pin_t fan)
+  : model(model), table(table), table_len(table_len) {
   heater_pin = heater;
   adc_pin = adc;
-  heat = 0.0;
+  last = Clock::nanos();
+  block_temperature = sensor_temperature = model.ambient;
+  adc_error = 0;
+  heater_pwm.attach(heater_pin, this, last);
+  if (fan != P_NC) fan_pwm.attach(fan, this, last);
+  Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = uint16_t(celsius_to_adc(sensor_temperature) * 4);
 }
 
 Heater::~Heater() {
 }
 
-void Heater::update() {
-  // crude pwm read and cruder heat simulation
-  auto now = Clock::micros();
-  double delta = (now - last);
-  if (delta > 1000 ) {
-    heater_state = pwmcap.update(0xFFFF * Gpio::pin_map[heater_pin].value);
-    last = now;
-    heat += (heater_state - heat) * (delta / 1000000000.0);
-
-    NOLESS(heat, room_temp_raw);
-    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = 0xFFFF - (uint16_t)heat;
+// Thermistor tables hold oversampled ADC readings, descending in temperature for NTCs
+float Heater::celsius_to_adc(const float celsius) const {
+  if (!table_len) return 0;
+  const float scale = 1.0f / ((OVERSAMPLENR) * (THERMISTOR_TABLE_SCALE));
+  for (uint8_t i = 1; i < table_len; i++) {
+    const temp_entry_t &a = table[i - 1], &b = table[i];
+    if (WITHIN(celsius, _MIN(a.celsius, b.celsius), _MAX(a.celsius, b.celsius))) {
+      const float f = a.celsius == b.celsius ? 0 : (celsius - a.celsius) / (b.celsius - a.celsius);
+      return (a.value + f * (b.value - a.value)) * scale;
+    }
   }
+  // Beyond the table the sensor rails
+  const bool ascending = table[table_len - 1].celsius > table[0].celsius,
+             above = celsius > (ascending ? table[table_len - 1].celsius : table[0].celsius);
+  return (above == ascending ? table[table_len - 1].value : table[0].value) * scale;
+}
+
+void Heater::update() {
+  const uint64_t now = Clock::nanos();
+  if (now - last < HEATER_UPDATE_NS) return;
+
+  const float dt = (now - last) / 1000000000.0f,
+              power = model.heater_power * heater_pwm.duty(last, now),
+              loss = (model.convection_loss + model.fan_loss * fan_pwm.duty(last, now)) * (block_temperature - model.ambient);
+  last = now;
+
+  block_temperature += (power - loss) * dt / model.heat_capacity;
+  sensor_temperature += (block_temperature - sensor_temperature) * _MIN(dt / model.sensor_lag, 1.0f);
+
+  // Carry the rounding error over, so oversampling resolves fractions of a count like a noisy ADC
+  const float adc = celsius_to_adc(sensor_temperature) + adc_error;
+  const uint16_t reading = constrain(lroundf(adc), 0, HAL_ADC_RANGE - 1);
+  adc_error = adc - reading;
+  // The HAL returns the upper 10 of 12 bits
+  Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = reading << 2;
 }
 
 void Heater::interrupt(GpioEvent ev) {
-  // unused
+  if (ev.event == GpioEvent::SETM) return;
+  if (ev.pin_id == heater_pwm.pin) heater_pwm.change(ev.timestamp);
+  else if (ev.pin_id == fan_pwm.pin) fan_pwm.change(ev.timestamp);
 }
 
 #endif // __PLAT_LINUX__
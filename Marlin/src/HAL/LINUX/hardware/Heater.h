@@ -22,26 +22,52 @@
 #pragma once
 
 #include "Gpio.h"
+#include "../../../module/thermistor/thermistors.h"
 
-struct LowpassFilter {
-  uint64_t data_delay = 0;
-  uint16_t update(uint16_t value) {
-    data_delay = data_delay - (data_delay >> 6) + value;
-    return (uint16_t)(data_delay >> 6);
-  }
+/**
+ * Physical parameters of a simulated heater. The block is heated by the
+ * cartridge and loses heat to the ambient air, more so with the part fan on.
+ * The thermistor follows the block with its own first order lag.
+ */
+struct ThermalModel {
+  float heater_power;       // (W) at 100% duty
+  float heat_capacity;      // (J/K) of the heater block
+  float convection_loss;    // (W/K) to ambient, still air
+  float fan_loss;           // (W/K) added at 100% part fan
+  float sensor_lag;         // (s) thermistor time constant
+  float ambient;            // (°C)
+};
+
+// Records the average duty of a soft or hardware PWM output from its edges
+struct PwmInput {
+  pin_t pin = P_NC;
+  float level = 0;
+  uint64_t last_change = 0;
+  double on_time = 0;       // (ns) at full level since the last duty() call
+
+  void attach(pin_t p, Peripheral *owner, uint64_t now);
+  void change(uint64_t timestamp);
+  float duty(uint64_t from, uint64_t now);
 };
 
 class Heater: public Peripheral {
 public:
-  Heater(pin_t heater, pin_t adc);
+  Heater(pin_t heater, pin_t adc, const ThermalModel &model, const temp_entry_t *table, uint8_t table_len, pin_t fan=P_NC);
   virtual ~Heater();
   void interrupt(GpioEvent ev);
   void update();
 
   pin_t heater_pin, adc_pin;
-  uint16_t room_temp_raw;
-  uint16_t heater_state;
-  LowpassFilter pwmcap;
-  double heat;
+  ThermalModel model;
+  const temp_entry_t *table;
+  uint8_t table_len;
+
+  PwmInput heater_pwm, fan_pwm;
+  float block_temperature;  // (°C)
+  float sensor_temperature; // (°C) as seen by the thermistor
+  float adc_error;          // Quantization error carried to the next sample
   uint64_t last;
+
+private:
+  float celsius_to_adc(const float celsius) const;
 };
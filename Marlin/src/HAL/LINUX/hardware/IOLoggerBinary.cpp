@@ -0,0 +1,100 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "IOLoggerBinary.h"
+#include "../../../inc/MarlinConfig.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+IOLoggerBinary::IOLoggerBinary(std::string filename, uint64_t capacity)
+  : fd(-1), capacity(capacity), map_size(0), header(nullptr), records(nullptr), next_record(0), overflow(0), flushed(0) {
+  fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    perror("IOLoggerBinary: open");
+    return;
+  }
+  map_size = sizeof(GpioTraceHeader) + capacity * sizeof(GpioTraceRecord);
+  void *map = MAP_FAILED;
+  if (ftruncate(fd, map_size) == 0)
+    map = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    perror("IOLoggerBinary: mmap");
+    close(fd);
+    fd = -1;
+    return;
+  }
+  header = (GpioTraceHeader*)map;
+  records = (GpioTraceRecord*)(header + 1);
+  memcpy(header->magic, "MGPT", 4);
+  header->version = version;
+  header->record_size = sizeof(GpioTraceRecord);
+  header->clock_frequency = F_CPU;
+}
+
+IOLoggerBinary::~IOLoggerBinary() {
+  if (!header) return;
+  const uint64_t used = count();
+  header->record_count = used;
+  header->dropped = dropped();
+  munmap(header, map_size);
+  if (ftruncate(fd, sizeof(GpioTraceHeader) + used * sizeof(GpioTraceRecord)) == -1)
+    perror("IOLoggerBinary: ftruncate");
+  close(fd);
+}
+
+uint64_t IOLoggerBinary::count() const {
+  return _MIN(next_record.load(std::memory_order_relaxed), capacity);
+}
+
+void IOLoggerBinary::log(GpioEvent ev) {
+  if (!records) return;
+  const uint64_t slot = next_record.fetch_add(1, std::memory_order_relaxed);
+  if (slot >= capacity) {
+    overflow.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  GpioTraceRecord &rec = records[slot];
+  rec.timestamp = ev.timestamp;
+  rec.pin_id = ev.pin_id;
+  rec.event = ev.event;
+  rec.value = Gpio::pin_map[ev.pin_id].value;
+}
+
+void IOLoggerBinary::flush() {
+  // Records are already in the page cache. Publish the count so a trace cut
+  // short by a kill is still readable, and start writeback of the new pages.
+  if (!header) return;
+  const uint64_t used = count();
+  if (used == flushed) return;
+  header->record_count = used;
+  header->dropped = dropped();
+  const uintptr_t page = sysconf(_SC_PAGESIZE),
+                  start = uintptr_t(&records[flushed]) & ~(page - 1);
+  msync((void*)start, uintptr_t(&records[used]) - start, MS_ASYNC);
+  flushed = used;
+}
+
+#endif // __PLAT_LINUX__
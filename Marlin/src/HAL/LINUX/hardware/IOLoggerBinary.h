@@ -0,0 +1,84 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <string>
+#include "Gpio.h"
+
+/**
+ * Binary GPIO event trace
+ *
+ * Fixed-size records are written straight into a memory-mapped file. A slot
+ * is claimed with a single atomic increment, so logging never allocates or
+ * locks and is safe from the signal handlers that run the wall-clock ISRs.
+ * The file is mapped sparse at full capacity and truncated on close; events
+ * past the capacity are counted and dropped.
+ *
+ * Read or convert a trace with buildroot/share/scripts/gpio_trace.py
+ */
+
+struct GpioTraceHeader {
+  char magic[4];          // "MGPT"
+  uint16_t version;
+  uint16_t record_size;
+  uint32_t clock_frequency;
+  uint32_t reserved;
+  uint64_t record_count;  // Updated on flush() and on close
+  uint64_t dropped;
+};
+
+struct GpioTraceRecord {
+  uint64_t timestamp;     // Clock::nanos()
+  int16_t pin_id;
+  uint8_t event;          // GpioEvent::Type
+  uint8_t reserved;
+  uint16_t value;         // Pin value after the event
+  uint16_t reserved2;
+};
+
+static_assert(sizeof(GpioTraceHeader) == 32, "GpioTraceHeader layout changed");
+static_assert(sizeof(GpioTraceRecord) == 16, "GpioTraceRecord layout changed");
+
+class IOLoggerBinary: public IOLogger {
+public:
+  static constexpr uint16_t version = 1;
+  static constexpr uint64_t default_capacity = 1ULL << 26; // records, 1GiB of sparse file
+
+  IOLoggerBinary(std::string filename, uint64_t capacity = default_capacity);
+  virtual ~IOLoggerBinary();
+  void flush();
+  void log(GpioEvent ev);
+
+  uint64_t count() const;
+  uint64_t dropped() const { return overflow.load(std::memory_order_relaxed); }
+
+private:
+  int fd;
+  uint64_t capacity;
+  size_t map_size;
+  GpioTraceHeader *header;
+  GpioTraceRecord *records;
+  std::atomic<uint64_t> next_record;
+  std::atomic<uint64_t> overflow;
+  uint64_t flushed;
+};
@@ -21,25 +21,49 @@
  */
 #ifdef __PLAT_LINUX__
 
-#include <random>
 #include <stdio.h>
+#include <math.h>
 #include "Clock.h"
+#include "../../../inc/MarlinConfig.h"
 #include "LinearAxis.h"
 
-LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max) {
+// Only the first few violations per axis are printed, the rest are counted
+#define MAX_REPORTED_VIOLATIONS 10
+
+uint32_t LinearAxis::step_cycles = 0;
+
+LinearAxis::LinearAxis(const AxisConfig &config, pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max) : config(config) {
   enable_pin = enable;
   dir_pin = dir;
   step_pin = step;
   min_pin = end_min;
   max_pin = end_max;
 
-  min_position = 50;
-  max_position = (200*80) + min_position;
-  position = rand() % ((max_position - 40) - min_position) + (min_position + 20);
+  min_position = lroundf(config.min_pos * config.steps_per_mm);
+  max_position = lroundf(config.max_pos * config.steps_per_mm);
+  // Power up somewhere in the middle, as nobody knows where the carriage is
+  position = config.bounded ? (min_position + max_position) / 2 : 0;
   last_update = Clock::nanos();
 
-  Gpio::attachPeripheral(step_pin, this);
+  velocity = 0;
+  direction = 0;
+  moving = false;
+  last_step = 0;
+  start_velocity = 0;
+  history_count = 0;
+  jerk_checked = false;
+  window_start = 0;
+  window_count = 0;
+  last_window_mid = 0;
+  have_window = false;
+  out_of_travel = false;
+  deflection = 0;
+  mass_velocity = 0;
+  last_step_swing = 0;
+  resonance_time = last_update;
 
+  Gpio::attachPeripheral(step_pin, this);
+  updateEndstops();
 }
 
 LinearAxis::~LinearAxis() {
@@ -47,19 +71,155 @@ LinearAxis::~LinearAxis() {
 }
 
 void LinearAxis::update() {
+  resonate(Clock::nanos());
 
+  // Settle the velocity once the axis has come to rest
+  if (moving && Clock::nanos() - last_step > standstill_ns) {
+    moving = false;
+    velocity = 0;
+    have_window = false;
+    NOLESS(report.peak_residual, float(last_step_swing));
+  }
 }
 
 void LinearAxis::interrupt(GpioEvent ev) {
-  if (ev.pin_id == step_pin && !Gpio::pin_map[enable_pin].value) {
+  if (ev.pin_id == step_pin && Gpio::pin_map[enable_pin].value == config.enable_on) {
     if (ev.event == GpioEvent::RISE) {
-      last_update = ev.timestamp;
-      position += -1 + 2 * Gpio::pin_map[dir_pin].value;
-      Gpio::pin_map[min_pin].value = (position < min_position);
-      //Gpio::pin_map[max_pin].value = (position > max_position);
-      //if (position < min_position) printf("axis(%d) endstop : pos: %d, mm: %f, min: %d\n", step_pin, position, position / 80.0, Gpio::pin_map[min_pin].value);
+      step(ev.timestamp, Gpio::pin_map[dir_pin].value != config.invert_dir ? 1 : -1);
+      if (step_cycles) Clock::delayCycles(step_cycles);
+    }
+  }
+}
+
+void LinearAxis::violation(uint32_t &counter, const char *what, float value, float limit, uint64_t timestamp) {
+  if (++counter <= MAX_REPORTED_VIOLATIONS)
+    fprintf(stderr, "sim: %s %s %.2f exceeds %.2f at %.6fs (%.3fmm)%s\n", config.name, what, value, limit,
+            timestamp / 1000000000.0, position_mm(), counter == MAX_REPORTED_VIOLATIONS ? ", further reports suppressed" : "");
+}
+
+// Speed over the slowest recent interval, which is exact for the leading axis
+// and discounts the uneven step spacing Bresenham gives the others
+float LinearAxis::recentVelocity() const {
+  uint64_t interval = 0;
+  for (uint8_t i = 1; i < history_count; i++) NOLESS(interval, history[i] - history[i - 1]);
+  return interval ? direction / (config.steps_per_mm * (interval / 1000000000.0f)) : 0;
+}
+
+/**
+ * Let the mass swing freely around the motor position up to the given time.
+ * Between steps the motor stands still, so this is the exact solution of
+ * u'' + 2ζωu' + ω²u = 0 for the deflection u.
+ */
+void LinearAxis::resonate(uint64_t timestamp) {
+  if (config.resonance_frequency <= 0 || timestamp <= resonance_time) return;
+  const double dt = (timestamp - resonance_time) / 1000000000.0,
+               w = 2 * M_PI * config.resonance_frequency, z = config.resonance_zeta,
+               wd = w * sqrt(1 - z * z), decay = exp(-z * w * dt),
+               c = cos(wd * dt), s = sin(wd * dt),
+               u = deflection, v = mass_velocity;
+  report.vibration_sq_time += u * u * dt;
+  report.vibration_time += dt;
+  deflection = decay * (u * c + (v + z * w * u) / wd * s);
+  mass_velocity = decay * (v * c - (w * w * u + z * w * v) / wd * s);
+  resonance_time = timestamp;
+  NOLESS(report.peak_vibration, float(fabs(deflection)));
+}
+
+/**
+ * Amplitude of the swing the mass would make if the motor stopped now
+ */
+double LinearAxis::swing() const {
+  const double w = 2 * M_PI * config.resonance_frequency, z = config.resonance_zeta,
+               wd = w * sqrt(1 - z * z), q = (mass_velocity + z * w * deflection) / wd;
+  return sqrt(deflection * deflection + q * q);
+}
+
+void LinearAxis::step(uint64_t timestamp, int8_t dir) {
+  resonate(timestamp);
+  if (config.resonance_frequency > 0) {
+    // The motor jumps a step: the spring is stretched by it and the damper jolted
+    const double d = dir / config.steps_per_mm;
+    deflection -= d;
+    mass_velocity += 2 * config.resonance_zeta * 2 * M_PI * config.resonance_frequency * d;
+    last_step_swing = swing();
+  }
+
+  position += dir;
+  report.steps++;
+  last_update = timestamp;
+
+  // A stop or reversal ends the current motion. The speed the axis is then
+  // thrown to instantly is what jerk limits.
+  const bool restart = !moving || dir != direction || timestamp - last_step > standstill_ns;
+  if (restart) {
+    start_velocity = (moving && dir != direction) ? recentVelocity() : 0;
+    moving = true;
+    direction = dir;
+    history_count = 0;
+    jerk_checked = false;
+    window_start = timestamp;
+    window_count = 0;
+    have_window = false;
+  }
+
+  if (history_count == COUNT(history)) memmove(history, history + 1, sizeof(history) - sizeof(history[0]));
+  else history_count++;
+  history[history_count - 1] = timestamp;
+
+  if (!jerk_checked && history_count == COUNT(history)) {
+    jerk_checked = true;
+    const float v = recentVelocity();
+    // Like the planner, a reversal is judged by the larger of the two speeds
+    const float jerk = (v > 0) == (start_velocity > 0) ? fabsf(v - start_velocity) : fmaxf(fabsf(v), fabsf(start_velocity));
+    NOLESS(report.peak_jerk, jerk);
+    if (jerk > config.max_jerk * 1.1f + 0.1f)
+      violation(report.jerk_violations, "jerk (mm/s)", jerk, config.max_jerk, timestamp);
+  }
+
+  if (!restart) {
+    if (++window_count >= window_steps && timestamp - window_start >= window_ns) {
+      const float v = dir * float(window_count) / (config.steps_per_mm * ((timestamp - window_start) / 1000000000.0f));
+      const uint64_t mid = (window_start + timestamp) / 2;
+      NOLESS(report.peak_velocity, fabsf(v));
+      if (fabsf(v) > config.max_feedrate * 1.05f)
+        violation(report.step_rate_violations, "speed (mm/s)", fabsf(v), config.max_feedrate, timestamp);
+      if (have_window) {
+        // A junction may also change the speed instantly by up to the jerk limit
+        const float dt = (mid - last_window_mid) / 1000000000.0f,
+                    a = fabsf(v - velocity) / dt,
+                    limit = config.max_acceleration * config.acceleration_tolerance + config.max_jerk * 1.1f / dt;
+        NOLESS(report.peak_acceleration, a);
+        if (a > limit)
+          violation(report.acceleration_violations, "acceleration (mm/s²)", a, config.max_acceleration, timestamp);
+      }
+      velocity = v;
+      last_window_mid = mid;
+      have_window = true;
+      window_start = timestamp;
+      window_count = 0;
     }
   }
+  last_step = timestamp;
+
+  if (config.bounded) {
+    // Hitting the frame is reported once per excursion
+    const bool outside = position < min_position - lroundf(config.steps_per_mm) || position > max_position + lroundf(config.steps_per_mm);
+    if (outside && !out_of_travel) violation(report.travel_violations, "travel (mm)", position_mm(), position < min_position ? config.min_pos : config.max_pos, timestamp);
+    out_of_travel = outside;
+  }
+
+  // Endstops abort the move at full speed, so motion starts over from rest
+  if (updateEndstops()) moving = false;
+}
+
+bool LinearAxis::updateEndstops() {
+  if (!config.bounded) return false;
+  const bool min_hit = min_pin != P_NC && position <= min_position,
+             max_hit = max_pin != P_NC && position >= max_position;
+  // A triggered switch reads !INVERTING, as Marlin tests READ(pin) != INVERTING
+  if (min_pin != P_NC) Gpio::pin_map[min_pin].value = min_hit != config.min_endstop_inverting;
+  if (max_pin != P_NC) Gpio::pin_map[max_pin].value = max_hit != config.max_endstop_inverting;
+  return min_hit || max_hit;
 }
 
 #endif // __PLAT_LINUX__
@@ -24,13 +24,60 @@
 #include <chrono>
 #include "Gpio.h"
 
+/**
+ * Physical description of one stepper driven axis, normally built from the
+ * DEFAULT_* and pin polarity settings in Configuration.h
+ */
+struct AxisConfig {
+  const char *name;
+  float steps_per_mm;
+  bool bounded;                 // Has travel limits (false for extruders)
+  float min_pos, max_pos;       // Travel (mm); the endstops trip at the ends
+  float max_feedrate;           // (mm/s)
+  float max_acceleration;       // (mm/s²)
+  float max_jerk;               // (mm/s) largest instant speed change
+  float acceleration_tolerance; // Allowed peak over max_acceleration (S-curve peaks at 1.5x)
+  bool invert_dir;              // DIR level for positive motion is !invert_dir
+  uint8_t enable_on;            // ENABLE level that powers the driver
+  bool min_endstop_inverting, max_endstop_inverting;
+  float resonance_frequency;    // (Hz) Of the toolhead or bed on its belt, 0 for a rigid axis
+  float resonance_zeta;         // Damping ratio of that resonance
+};
+
+/**
+ * Per-axis motion statistics and limit violations
+ */
+struct AxisReport {
+  uint32_t step_rate_violations = 0;
+  uint32_t acceleration_violations = 0;
+  uint32_t jerk_violations = 0;
+  uint32_t travel_violations = 0;
+  float peak_velocity = 0;      // (mm/s)
+  float peak_acceleration = 0;  // (mm/s²)
+  float peak_jerk = 0;          // (mm/s)
+  float peak_vibration = 0;     // (mm) Largest deflection of the resonating mass from the motor position
+  double vibration_sq_time = 0; // (mm²·s) Integral of the squared deflection
+  double vibration_time = 0;    // (s) Time covered by the integral
+  float peak_residual = 0;      // (mm) Largest free swing left over when the axis came to rest
+  uint64_t steps = 0;
+
+  float rms_vibration() const { return vibration_time > 0 ? sqrt(vibration_sq_time / vibration_time) : 0; }
+
+  uint32_t violations() const { return step_rate_violations + acceleration_violations + jerk_violations + travel_violations; }
+};
+
 class LinearAxis: public Peripheral {
 public:
-  LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max);
+  LinearAxis(const AxisConfig &config, pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max);
   virtual ~LinearAxis();
   void update();
   void interrupt(GpioEvent ev);
 
+  float position_mm() const { return position / config.steps_per_mm; }
+
+  AxisConfig config;
+  AxisReport report;
+
   pin_type enable_pin;
   pin_type dir_pin;
   pin_type step_pin;
@@ -42,4 +89,41 @@ public:
   int32_t max_position;
   uint64_t last_update;
 
+  float velocity;               // (mm/s) signed, from the last measurement window
+
+  static uint32_t step_cycles;  // CPU cycles each step pulse costs the firmware, to model a slower MCU
+
+private:
+  void step(uint64_t timestamp, int8_t direction);
+  bool updateEndstops();
+  void violation(uint32_t &counter, const char *what, float value, float limit, uint64_t timestamp);
+
+  float recentVelocity() const;
+  void resonate(uint64_t timestamp);
+  double swing() const;
+
+  // Velocity is measured over windows of steps so that multi-stepping bursts
+  // average out. Jerk looks at the first few intervals of a motion.
+  static constexpr uint8_t window_steps = 16;
+  static constexpr uint64_t window_ns = 250000;
+  static constexpr uint64_t standstill_ns = 50000000; // No step for this long means stopped
+
+  int8_t direction;
+  bool moving;
+  uint64_t last_step;
+  float start_velocity;         // (mm/s) signed, before the current motion started
+  uint64_t history[4];          // Latest step times of the current motion
+  uint8_t history_count;
+  bool jerk_checked;
+  uint64_t window_start;
+  uint32_t window_count;
+  uint64_t last_window_mid;
+  bool have_window;
+  bool out_of_travel;
+
+  // Mass on a spring and damper, pulled along by the motor
+  double deflection;            // (mm) Mass position relative to the motor
+  double mass_velocity;         // (mm/s)
+  double last_step_swing;       // (mm) Amplitude of the free swing after the last step
+  uint64_t resonance_time;
 };
@@ -0,0 +1,69 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "Scheduler.h"
+#include "Timer.h"
+
+std::priority_queue<Scheduler::Event, std::vector<Scheduler::Event>, std::greater<Scheduler::Event>> Scheduler::events;
+uint64_t Scheduler::sequence = 0;
+uint8_t Scheduler::isr_depth = 0;
+uint64_t Scheduler::isr_nanos = 0;
+
+void Scheduler::schedule(Timer* timer, uint64_t timestamp) {
+  events.push({ timestamp, sequence++, ++timer->generation, timer });
+}
+
+void Scheduler::dispatch(const Event& ev) {
+  if (ev.generation != ev.timer->generation) return; // superseded by a later setCompare
+  // An event is never run before the current time, but it may run late when a
+  // callback has delayed past it, just as a real interrupt would be held off
+  if (ev.timestamp > Clock::virtual_nanos) Clock::virtual_nanos = ev.timestamp;
+  const uint64_t start = Clock::virtual_nanos;
+  isr_depth++;
+  ev.timer->fire(ev.timestamp);
+  isr_depth--;
+  isr_nanos += Clock::virtual_nanos - start;
+}
+
+void Scheduler::advanceTo(uint64_t timestamp) {
+  // Delays inside a callback only consume time; the pending events are
+  // picked up by the outer loop once the callback returns
+  if (!inInterrupt())
+    while (!events.empty() && events.top().timestamp <= timestamp) {
+      const Event ev = events.top();
+      events.pop();
+      dispatch(ev);
+    }
+  if (timestamp > Clock::virtual_nanos) Clock::virtual_nanos = timestamp;
+}
+
+bool Scheduler::runNextEvent() {
+  if (inInterrupt()) return false;
+  // Drop superseded events so the jump lands on a live one
+  while (!events.empty() && events.top().generation != events.top().timer->generation) events.pop();
+  if (events.empty()) return false;
+  advanceTo(events.top().timestamp);
+  return true;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,79 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Discrete-event scheduler for virtual time
+ *
+ * Every armed Timer has one pending event in a priority queue. Time only moves
+ * when the firmware delays or idles: the Clock is stepped to each due event in
+ * order and the timer callback (the "ISR") is run synchronously. No signals or
+ * threads are involved, so a run is deterministic and as fast as the host allows.
+ */
+
+#include <stdint.h>
+#include <queue>
+#include <vector>
+
+#include "Clock.h"
+
+class Timer;
+
+class Scheduler {
+public:
+  // Queue an event for the timer, superseding any event it queued before
+  static void schedule(Timer* timer, uint64_t timestamp);
+
+  // Run every event due up to the given time, then leave the Clock there
+  static void advanceTo(uint64_t timestamp);
+
+  static void advance(uint64_t ns) {
+    advanceTo(Clock::nanos() + ns);
+  }
+
+  // Jump straight to the next pending event; false if nothing is pending
+  static bool runNextEvent();
+
+  static bool inInterrupt() { return isr_depth > 0; }
+
+  // Virtual nanoseconds spent inside timer callbacks
+  static uint64_t interruptNanos() { return isr_nanos; }
+
+private:
+  struct Event {
+    uint64_t timestamp;
+    uint64_t sequence;  // Keeps events with equal timestamps in FIFO order
+    uint32_t generation;
+    Timer* timer;
+
+    bool operator>(const Event& other) const {
+      return timestamp != other.timestamp ? timestamp > other.timestamp : sequence > other.sequence;
+    }
+  };
+
+  static void dispatch(const Event& ev);
+
+  static std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+  static uint64_t sequence;
+  static uint8_t isr_depth;
+  static uint64_t isr_nanos;
+};
@@ -22,10 +22,14 @@
 #ifdef __PLAT_LINUX__
 
 #include "Timer.h"
+#include "Scheduler.h"
 #include <stdio.h>
+#include <algorithm>
 
 Timer::Timer() {
   active = false;
+  pending = false;
+  generation = 0;
   compare = 0;
   frequency = 0;
   overruns = 0;
@@ -37,7 +41,7 @@ Timer::Timer() {
 }
 
 Timer::~Timer() {
-  timer_delete(timerid);
+  if (!Clock::isVirtual()) timer_delete(timerid);
 }
 
 void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
@@ -47,6 +51,8 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
   frequency = sim_freq;
   cbfn = fn;
 
+  if (Clock::isVirtual()) return; // Events are dispatched by the Scheduler
+
   sa.sa_flags = SA_SIGINFO;
   sa.sa_sigaction = Timer::handler;
   sigemptyset(&sa.sa_mask);
@@ -73,6 +79,15 @@ void Timer::start(uint32_t frequency) {
 }
 
 void Timer::enable() {
+  if (Clock::isVirtual()) {
+    active = true;
+    // Deliver a compare that matched while masked, as the NVIC would
+    if (pending) {
+      pending = false;
+      Scheduler::schedule(this, Clock::nanos());
+    }
+    return;
+  }
   if (sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -81,6 +96,10 @@ void Timer::enable() {
 }
 
 void Timer::disable() {
+  if (Clock::isVirtual()) {
+    active = false;
+    return;
+  }
   if (sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -88,6 +107,13 @@ void Timer::disable() {
 }
 
 void Timer::setCompare(uint32_t compare) {
+  if (Clock::isVirtual()) {
+    this->compare = compare;
+    this->period = std::max<uint64_t>(Clock::ticksToNanos(compare, frequency), 1);
+    this->start_time = Clock::nanos();
+    Scheduler::schedule(this, this->start_time + this->period);
+    return;
+  }
   uint32_t nsec_offset = 0;
   if (active) {
     nsec_offset = Clock::nanos() - this->start_time; // calculate how long the timer would have been running for
@@ -110,7 +136,21 @@ void Timer::setCompare(uint32_t compare) {
   this->start_time = Clock::nanos();
 }
 
+void Timer::fire(uint64_t timestamp) {
+  // Periodic, like the interval timer used on wall-clock time
+  start_time = timestamp;
+  Scheduler::schedule(this, start_time + period);
+  if (!active) {
+    pending = true;
+    return;
+  }
+  cbfn();
+}
+
 uint32_t Timer::getCount() {
+  // Reading the counter costs one tick of virtual time so that pulse-width
+  // polling loops (AWAIT_HIGH_PULSE etc.) terminate
+  if (Clock::isVirtual()) Scheduler::advance(Clock::ticksToNanos(1, frequency));
   return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
 }
 
@@ -48,6 +48,9 @@ public:
   uint32_t getOverruns() {return overruns;}
   uint32_t getAvgError() {return avg_error;}
 
+  // Called by the Scheduler when running on virtual time
+  void fire(uint64_t timestamp);
+
   intptr_t getID() {
     return (*(intptr_t*)timerid);
   }
@@ -63,7 +66,11 @@ public:
   }
 
 private:
+  friend class Scheduler;
+
   bool active;
+  bool pending;         // Virtual time: event came due while disabled
+  uint32_t generation;  // Virtual time: identifies the live scheduled event
   uint32_t compare;
   uint32_t frequency;
   uint32_t overruns;
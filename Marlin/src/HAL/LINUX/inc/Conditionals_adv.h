@@ -20,3 +20,6 @@
  *
  */
 #pragma once
+
+// The simulator can benchmark the planner against replanning the whole buffer
+#define PLANNER_BENCHMARK
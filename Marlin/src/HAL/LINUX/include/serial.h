@@ -29,49 +29,130 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <atomic>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 /**
- * Generic RingBuffer
+ * Lock-free single-producer / single-consumer RingBuffer
  * T type of the buffer array
  * S size of the buffer (must be power of 2)
+ *
+ * The indices are free-running and each is only ever stored by one side, so
+ * no lock is needed. A side that has nothing to do can sleep on the other
+ * side's index with a futex instead of spinning; it is only woken (one
+ * syscall) when it has flagged itself as waiting.
  */
 template <typename T, uint32_t S> class RingBuffer {
 public:
-  RingBuffer() { index_read = index_write = 0; }
-  uint32_t available() volatile { return index_write - index_read; }
-  uint32_t free() volatile      { return buffer_size - available(); }
-  bool empty() volatile         { return index_read == index_write; }
-  bool full() volatile          { return available() == buffer_size; }
-  void clear() volatile         { index_read = index_write = 0; }
-
-  bool peek(T *value) volatile {
+  RingBuffer() { index_read = index_write = 0; reader_waiting = writer_waiting = false; }
+  uint32_t available() const { return index_write.load(std::memory_order_acquire) - index_read.load(std::memory_order_acquire); }
+  uint32_t free() const      { return buffer_size - available(); }
+  bool empty() const         { return available() == 0; }
+  bool full() const          { return available() == buffer_size; }
+  void clear()               { index_read.store(index_write.load(std::memory_order_acquire), std::memory_order_release); wake_writer(); } // Consumer side only
+
+  bool peek(T *value) const {
     if (value == 0 || available() == 0)
       return false;
-    *value = buffer[mask(index_read)];
+    *value = buffer[mask(index_read.load(std::memory_order_relaxed))];
     return true;
   }
 
-  int read() volatile {
+  int read() {
     if (empty()) return -1;
-    return buffer[mask(index_read++)];
+    const uint32_t r = index_read.load(std::memory_order_relaxed);
+    const T value = buffer[mask(r)];
+    index_read.store(r + 1, std::memory_order_release);
+    wake_writer();
+    return value;
   }
 
-  bool write(T value) volatile {
+  bool write(T value) {
     if (full()) return false;
-    buffer[mask(index_write++)] = value;
+    const uint32_t w = index_write.load(std::memory_order_relaxed);
+    buffer[mask(w)] = value;
+    index_write.store(w + 1, std::memory_order_release);
+    wake_reader();
     return true;
   }
 
+  // Bulk transfers, at most one wakeup per call
+  uint32_t read(T *dest, uint32_t count) {
+    const uint32_t r = index_read.load(std::memory_order_relaxed);
+    count = _MIN(count, available());
+    for (uint32_t i = 0; i < count; i++) dest[i] = buffer[mask(r + i)];
+    if (count) {
+      index_read.store(r + count, std::memory_order_release);
+      wake_writer();
+    }
+    return count;
+  }
+
+  uint32_t write(const T *src, uint32_t count) {
+    const uint32_t w = index_write.load(std::memory_order_relaxed);
+    count = _MIN(count, free());
+    for (uint32_t i = 0; i < count; i++) buffer[mask(w + i)] = src[i];
+    if (count) {
+      index_write.store(w + count, std::memory_order_release);
+      wake_reader();
+    }
+    return count;
+  }
+
+  // Block the consumer until there is data
+  void wait_for_data() {
+    reader_waiting.store(true);
+    for (uint32_t w; (w = index_write.load()) == index_read.load(std::memory_order_relaxed);)
+      futex_wait(index_write, w);
+    reader_waiting.store(false, std::memory_order_relaxed);
+  }
+
+  // Block the producer until there is room
+  void wait_for_space() {
+    writer_waiting.store(true);
+    for (uint32_t r; index_write.load(std::memory_order_relaxed) - (r = index_read.load()) == buffer_size;)
+      futex_wait(index_read, r);
+    writer_waiting.store(false, std::memory_order_relaxed);
+  }
+
+  // Block the producer until the consumer has taken everything
+  void wait_for_empty() {
+    writer_waiting.store(true);
+    for (uint32_t r; index_write.load(std::memory_order_relaxed) != (r = index_read.load());)
+      futex_wait(index_read, r);
+    writer_waiting.store(false, std::memory_order_relaxed);
+  }
+
 private:
-  uint32_t mask(uint32_t val) volatile {
+  static uint32_t mask(uint32_t val) {
     return buffer_mask & val;
   }
 
+  // Sleep while the index still holds the value we last saw
+  static void futex_wait(std::atomic<uint32_t> &index, uint32_t seen) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&index), FUTEX_WAIT_PRIVATE, seen, nullptr, nullptr, 0);
+  }
+
+  static void futex_wake(std::atomic<uint32_t> &index) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&index), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+  }
+
+  // The seq_cst store of an index and load of the flag pair with the waiter's
+  // seq_cst store of its flag and load of the index: one side always sees the other
+  void wake_reader() { std::atomic_thread_fence(std::memory_order_seq_cst); if (reader_waiting.load()) futex_wake(index_write); }
+  void wake_writer() { std::atomic_thread_fence(std::memory_order_seq_cst); if (writer_waiting.load()) futex_wake(index_read); }
+
   static const uint32_t buffer_size = S;
   static const uint32_t buffer_mask = buffer_size - 1;
-  volatile T buffer[buffer_size];
-  volatile uint32_t index_write;
-  volatile uint32_t index_read;
+  static_assert(!(buffer_size & buffer_mask), "RingBuffer size must be a power of 2");
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+  T buffer[buffer_size];
+  std::atomic<uint32_t> index_write;
+  std::atomic<uint32_t> index_read;
+  std::atomic<bool> reader_waiting;
+  std::atomic<bool> writer_waiting;
 };
 
 struct HalSerial {
@@ -89,7 +170,7 @@ struct HalSerial {
 
   size_t write(char c) {
     if (!host_connected) return 0;
-    while (!transmit_buffer.free());
+    if (!transmit_buffer.free()) transmit_buffer.wait_for_space();
     return transmit_buffer.write(c);
   }
 
@@ -106,12 +187,11 @@ struct HalSerial {
   }
 
   void flushTX() {
-    if (host_connected)
-      while (transmit_buffer.available()) { /* nada */ }
+    if (host_connected) transmit_buffer.wait_for_empty();
   }
 
-  volatile RingBuffer<uint8_t, 128> receive_buffer;
-  volatile RingBuffer<uint8_t, 128> transmit_buffer;
+  RingBuffer<uint8_t, 128> receive_buffer;
+  RingBuffer<uint8_t, 128> transmit_buffer;
   volatile bool host_connected;
 };
 
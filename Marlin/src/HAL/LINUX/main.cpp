@@ -26,67 +26,171 @@
 
 #include "../../inc/MarlinConfig.h"
 #include "../shared/Delay.h"
-#include "hardware/IOLoggerCSV.h"
+#include "hardware/IOLoggerBinary.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "hardware/Timer.h"
+#include "hardware/Scheduler.h"
+#include "benchmark.h"
+#include "../../module/planner.h"
+#include "../../module/motion.h"
+#include "../../gcode/queue.h"
 
 #include <stdio.h>
 #include <stdarg.h>
 #include <thread>
 #include <iostream>
 #include <fstream>
+#include <getopt.h>
+#include <inttypes.h>
+#include <chrono>
+#include <errno.h>
+#include <unistd.h>
 
 extern void setup();
 extern void loop();
 
+// Serial output goes here, or nowhere if null
+FILE *serial_out = stdout;
+
 // simple stdout / stdin implementation for fake serial port
+// Both threads sleep on the ring buffers and move whole batches per syscall
 void write_serial_thread() {
+  uint8_t buffer[128];
   for (;;) {
-    for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
-      fputc(usb_serial.transmit_buffer.read(), stdout);
-    }
-    std::this_thread::yield();
+    usb_serial.transmit_buffer.wait_for_data();
+    const std::size_t len = usb_serial.transmit_buffer.read(buffer, sizeof(buffer));
+    if (!serial_out) continue;
+    fwrite(buffer, 1, len, serial_out);
+    if (usb_serial.transmit_buffer.empty()) fflush(serial_out);
   }
 }
 
 void read_serial_thread() {
-  char buffer[255] = {};
+  uint8_t buffer[128];
   for (;;) {
-    std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
-    if (fgets(buffer, len, stdin))
-      for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
-    std::this_thread::yield();
+    usb_serial.receive_buffer.wait_for_space();
+    const ssize_t len = read(STDIN_FILENO, buffer, _MIN(usb_serial.receive_buffer.free(), sizeof(buffer)));
+    if (len < 0 && errno == EINTR) continue; // Timer signals interrupt the read
+    if (len <= 0) break; // EOF or error, the host has gone away
+    for (ssize_t i = 0; i < len;) {
+      i += usb_serial.receive_buffer.write(buffer + i, len - i);
+      if (i < len) usb_serial.receive_buffer.wait_for_space();
+    }
   }
 }
 
-void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
-  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+// Resonance of the X and Y axes as { Hz, damping ratio }, to see ringing in the summary.
+// A light toolhead on X and a heavier bed on Y, as on a typical bed-slinger.
+#ifndef SIMULATED_X_RESONANCE
+  #define SIMULATED_X_RESONANCE { 40, 0.1 }
+#endif
+#ifndef SIMULATED_Y_RESONANCE
+  #define SIMULATED_Y_RESONANCE { 30, 0.1 }
+#endif
 
-  #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
+// Axis models taken from the machine configuration
+namespace axis_config {
+  constexpr float steps_per_mm[] = DEFAULT_AXIS_STEPS_PER_UNIT,
+                  max_feedrate[] = DEFAULT_MAX_FEEDRATE,
+                  max_acceleration[] = DEFAULT_MAX_ACCELERATION;
+  #if HAS_CLASSIC_JERK
+    constexpr float max_jerk[] = { DEFAULT_XJERK, DEFAULT_YJERK, DEFAULT_ZJERK };
+  #else
+    constexpr float max_jerk[] = DEFAULT_MAX_FEEDRATE; // Junction deviation has no per-axis jerk to check
+  #endif
+  #ifdef DEFAULT_EJERK
+    constexpr float e_jerk = DEFAULT_EJERK;
+  #else
+    constexpr float e_jerk = max_feedrate[E_AXIS];
+  #endif
+  // S-curve acceleration peaks at 1.5x the trapezoid value, plus some room for step quantization
+  constexpr float acceleration_tolerance = TERN(S_CURVE_ACCELERATION, 1.5f, 1.0f) * 1.25f;
+  constexpr float x_resonance[] = SIMULATED_X_RESONANCE, y_resonance[] = SIMULATED_Y_RESONANCE,
+                  rigid[] = { 0, 0 };
+  constexpr const float* resonance(const AxisEnum axis) { return axis == X_AXIS ? x_resonance : axis == Y_AXIS ? y_resonance : rigid; }
 
-    std::ofstream position_log;
-    position_log.open("axis_position_log.csv");
+  constexpr AxisConfig linear(const char *name, const AxisEnum axis, const float min_pos, const float max_pos,
+                              const bool invert_dir, const uint8_t enable_on, const bool min_inverting, const bool max_inverting) {
+    return { name, steps_per_mm[axis], true, min_pos, max_pos, max_feedrate[axis], max_acceleration[axis],
+             max_jerk[axis], acceleration_tolerance, invert_dir, enable_on, min_inverting, max_inverting,
+             resonance(axis)[0], resonance(axis)[1] };
+  }
 
-    int32_t x,y,z;
+  constexpr AxisConfig extruder(const char *name, const bool invert_dir) {
+    return { name, steps_per_mm[E_AXIS], false, 0, 0, max_feedrate[E_AXIS], max_acceleration[E_AXIS],
+             e_jerk, acceleration_tolerance, invert_dir, E_ENABLE_ON, false, false, 0, 0 };
+  }
+
+  constexpr AxisConfig X = linear("X", X_AXIS, X_MIN_POS, X_MAX_POS, INVERT_X_DIR, X_ENABLE_ON, X_MIN_ENDSTOP_INVERTING, X_MAX_ENDSTOP_INVERTING),
+                       Y = linear("Y", Y_AXIS, Y_MIN_POS, Y_MAX_POS, INVERT_Y_DIR, Y_ENABLE_ON, Y_MIN_ENDSTOP_INVERTING, Y_MAX_ENDSTOP_INVERTING),
+                       Z = linear("Z", Z_AXIS, Z_MIN_POS, Z_MAX_POS, INVERT_Z_DIR, Z_ENABLE_ON, Z_MIN_ENDSTOP_INVERTING, Z_MAX_ENDSTOP_INVERTING);
+  #if HAS_Z2_STEP
+    // Z2 shares the Z enable and is driven with DIR ^ INVERT_Z2_VS_Z_DIR
+    constexpr AxisConfig Z2 = linear("Z2", Z_AXIS, Z_MIN_POS, Z_MAX_POS, INVERT_Z_DIR != ENABLED(INVERT_Z2_VS_Z_DIR), Z_ENABLE_ON,
+                                     TERN(HAS_Z2_MIN, Z2_MIN_ENDSTOP_INVERTING, false), TERN(HAS_Z2_MAX, Z2_MAX_ENDSTOP_INVERTING, false));
   #endif
+}
 
-  for (;;) {
+// Thermal plant of the simulated heaters as { W, J/K, W/K, W/K with fan, sensor lag s, ambient °C }.
+// Override these to tune PID or test thermal protection against a particular machine.
+#ifndef SIMULATED_HOTEND_MODEL
+  #define SIMULATED_HOTEND_MODEL { 40, 12, 0.12, 0.08, 1.5, 25 }
+#endif
+#ifndef SIMULATED_BED_MODEL
+  #define SIMULATED_BED_MODEL { 250, 900, 1.6, 0, 4, 25 }
+#endif
+
+// Endstops are only simulated where they are in use, as unused pins may be shared (e.g. Z2_USE_ENDSTOP)
+#define SIM_ENDSTOP(A) TERN(HAS_##A, A##_PIN, P_NC)
+
+// Simulated hardware, owned by the simulation thread or the virtual-time scheduler
+struct SimulatedMachine {
+  Heater hotend{HEATER_0_PIN, TEMP_0_PIN, SIMULATED_HOTEND_MODEL, TEMPTABLE_0, TEMPTABLE_0_LEN, TERN(HAS_FAN0, FAN_PIN, P_NC)};
+  #if HAS_HEATED_BED
+    Heater bed{HEATER_BED_PIN, TEMP_BED_PIN, SIMULATED_BED_MODEL, TEMPTABLE_BED, TEMPTABLE_BED_LEN};
+  #endif
+  LinearAxis x_axis{axis_config::X, X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, SIM_ENDSTOP(X_MIN), SIM_ENDSTOP(X_MAX)};
+  LinearAxis y_axis{axis_config::Y, Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, SIM_ENDSTOP(Y_MIN), SIM_ENDSTOP(Y_MAX)};
+  LinearAxis z_axis{axis_config::Z, Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, SIM_ENDSTOP(Z_MIN), SIM_ENDSTOP(Z_MAX)};
+  #if HAS_Z2_STEP
+    LinearAxis z2_axis{axis_config::Z2, Z2_ENABLE_PIN, Z2_DIR_PIN, Z2_STEP_PIN, SIM_ENDSTOP(Z2_MIN), SIM_ENDSTOP(Z2_MAX)};
+  #endif
+  LinearAxis extruder0{axis_config::extruder("E0", INVERT_E0_DIR), E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC};
+  #if HAS_E1_STEP
+    LinearAxis extruder1{axis_config::extruder("E1", INVERT_E1_DIR), E1_ENABLE_PIN, E1_DIR_PIN, E1_STEP_PIN, P_NC, P_NC};
+  #endif
+  #if HAS_E2_STEP
+    LinearAxis extruder2{axis_config::extruder("E2", INVERT_E2_DIR), E2_ENABLE_PIN, E2_DIR_PIN, E2_STEP_PIN, P_NC, P_NC};
+  #endif
+
+  #ifdef GPIO_LOGGING
+    IOLoggerBinary logger{"all_gpio_log.bin"};
+    std::ofstream position_log{"axis_position_log.csv"};
+    int32_t x, y, z;
+
+    SimulatedMachine() { Gpio::attachLogger(&logger); }
+  #endif
 
+  template<typename F> void for_each_axis(F f) {
+    f(x_axis); f(y_axis); f(z_axis);
+    TERN_(HAS_Z2_STEP, f(z2_axis));
+    f(extruder0);
+    TERN_(HAS_E1_STEP, f(extruder1));
+    TERN_(HAS_E2_STEP, f(extruder2));
+  }
+
+  void update() {
     hotend.update();
-    bed.update();
+    TERN_(HAS_HEATED_BED, bed.update());
 
     x_axis.update();
     y_axis.update();
     z_axis.update();
+    TERN_(HAS_Z2_STEP, z2_axis.update());
     extruder0.update();
+    TERN_(HAS_E1_STEP, extruder1.update());
+    TERN_(HAS_E2_STEP, extruder2.update());
 
     #ifdef GPIO_LOGGING
       if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
@@ -100,14 +204,196 @@ void simulation_loop() {
       // flush the logger
       logger.flush();
     #endif
+  }
+};
 
+SimulatedMachine *machine = nullptr;
+
+void simulation_loop() {
+  SimulatedMachine sim;
+  machine = &sim;
+  for (;;) {
+    sim.update();
     std::this_thread::yield();
   }
 }
 
-int main() {
+// On virtual time the peripherals are stepped from a scheduler event instead
+#define SIMULATION_TIMER_RATE      1000000
+#define SIMULATION_TIMER_FREQUENCY 1000
+
+/**
+ * Batch simulation: G-code is fed straight from a file into the serial
+ * receive buffer whenever the firmware has room, so no virtual time passes
+ * waiting for a host. When everything has been executed a JSON summary is
+ * written and the process exits.
+ */
+struct BatchRun {
+  static constexpr uint32_t load_window = 10; // Simulation ticks per ISR load sample
+
+  FILE *gcode = nullptr;
+  const char *gcode_path = nullptr;
+  const char *summary_path = nullptr;
+  uint64_t time_limit = 0;        // (ns) of virtual time, 0 for none
+
+  uint64_t start_time = 0;        // Virtual time when the job started
+  std::chrono::steady_clock::time_point start_wall;
+  uint64_t bytes_fed = 0;
+
+  // Planner stalls: the block buffer ran dry with G-code still to execute
+  bool planner_was_busy = false;
+  uint32_t planner_stalls = 0;
+  uint64_t stall_start = 0, stall_time = 0;
+
+  // Share of virtual time spent in interrupt handlers
+  uint32_t load_ticks = 0;
+  uint64_t load_start = 0, load_isr_start = 0;
+  float max_isr_load = 0;
+
+  bool active() const { return gcode != nullptr; }
+  bool pending() const { return !feof(gcode) || usb_serial.available() || queue.has_commands_queued(); }
+
+  void begin() {
+    start_time = load_start = Clock::nanos();
+    load_isr_start = Scheduler::interruptNanos();
+    start_wall = std::chrono::steady_clock::now();
+  }
+
+  // Top up the receive buffer from the file
+  void feed() {
+    uint8_t buffer[128];
+    const std::size_t len = fread(buffer, 1, _MIN(usb_serial.receive_buffer.free(), sizeof(buffer)), gcode);
+    usb_serial.receive_buffer.write(buffer, len);
+    bytes_fed += len;
+  }
+
+  bool finished() const { return !pending() && !planner.busy(); }
+
+  // Called from the simulation timer
+  void sample() {
+    const uint64_t now = Clock::nanos();
+    const bool busy = planner.has_blocks_queued();
+    if (planner_was_busy && !busy && pending()) { planner_stalls++; stall_start = now; }
+    if (!planner_was_busy && busy && stall_start) { stall_time += now - stall_start; stall_start = 0; }
+    planner_was_busy = busy;
+
+    if (++load_ticks >= load_window) {
+      const uint64_t isr = Scheduler::interruptNanos();
+      if (now > load_start) NOLESS(max_isr_load, float(isr - load_isr_start) / (now - load_start));
+      load_start = now;
+      load_isr_start = isr;
+      load_ticks = 0;
+    }
+
+    if (time_limit && now - start_time > time_limit) finish(false);
+  }
+
+  static void json_axis(FILE *out, const LinearAxis &axis, const bool last) {
+    const AxisReport &r = axis.report;
+    fprintf(out, "    \"%s\": { \"steps\": %" PRIu64 ", \"position\": %.3f, \"peak_velocity\": %.2f, \"peak_acceleration\": %.1f, \"peak_jerk\": %.2f,\n",
+            axis.config.name, r.steps, axis.position_mm(), r.peak_velocity, r.peak_acceleration, r.peak_jerk);
+    if (axis.config.resonance_frequency > 0)
+      fprintf(out, "      \"vibration\": { \"peak\": %.4f, \"rms\": %.4f, \"residual\": %.4f },\n", r.peak_vibration, r.rms_vibration(), r.peak_residual);
+    fprintf(out, "      \"violations\": { \"step_rate\": %u, \"acceleration\": %u, \"jerk\": %u, \"travel\": %u } }%s\n",
+            r.step_rate_violations, r.acceleration_violations, r.jerk_violations, r.travel_violations, last ? "" : ",");
+  }
+
+  [[noreturn]] void finish(const bool completed) {
+    MYSERIAL1.flushTX();
+    const uint64_t now = Clock::nanos();
+    if (stall_start) stall_time += now - stall_start;
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_wall).count(),
+                 elapsed = (now - start_time) / 1e9;
+
+    FILE *out = summary_path ? fopen(summary_path, "w") : stdout;
+    if (!out) { perror(summary_path); _exit(1); }
+    fprintf(out, "{\n  \"file\": \"%s\",\n  \"completed\": %s,\n  \"bytes\": %" PRIu64 ",\n", gcode_path, completed ? "true" : "false", bytes_fed);
+    fprintf(out, "  \"print_time\": %.3f,\n  \"wall_time\": %.3f,\n", elapsed, wall);
+    fprintf(out, "  \"planner\": { \"stalls\": %u, \"stall_time\": %.3f },\n", planner_stalls, stall_time / 1e9);
+    fprintf(out, "  \"isr\": { \"max_load\": %.4f, \"average_load\": %.4f },\n", max_isr_load,
+            now > start_time ? double(Scheduler::interruptNanos()) / (now - start_time) : 0.0);
+    fprintf(out, "  \"position\": { \"X\": %.3f, \"Y\": %.3f, \"Z\": %.3f, \"E\": %.3f },\n",
+            current_position.x, current_position.y, current_position.z, current_position.e);
+    fprintf(out, "  \"steppers\": {\n");
+    uint8_t count = 0, index = 0;
+    machine->for_each_axis([&](LinearAxis &) { count++; });
+    machine->for_each_axis([&](LinearAxis &axis) { json_axis(out, axis, ++index == count); });
+    fprintf(out, "  }\n}\n");
+    fclose(out);
+
+    // Tear down the simulated hardware to finalize any trace files
+    delete machine;
+    if (serial_out) fflush(serial_out);
+    _exit(completed ? 0 : 2);
+  }
+};
+
+BatchRun batch;
+
+Timer simulation_timer;
+void simulation_isr() {
+  machine->update();
+  if (batch.active()) batch.sample();
+}
+
+void usage(const char *name) {
+  fprintf(stderr, "Usage: %s [--virtual-time] [--batch FILE [--summary FILE] [--time-limit SECONDS] [--step-cycles N] [--quiet]] [--benchmark NAME]\n", name);
+  fprintf(stderr, "  --virtual-time       Run on deterministic discrete-event time instead of the wall clock\n");
+  fprintf(stderr, "  --batch FILE         Run a G-code file at full speed on virtual time and exit with a JSON summary\n");
+  fprintf(stderr, "  --summary FILE       Write the summary to FILE instead of stdout\n");
+  fprintf(stderr, "  --time-limit SECONDS Give up after this much virtual time\n");
+  fprintf(stderr, "  --step-cycles N      Charge N virtual CPU cycles per step pulse, as a slower MCU would take\n");
+  fprintf(stderr, "  --quiet              Discard the serial output, which goes to stderr in batch mode\n");
+  fprintf(stderr, "  --benchmark NAME     Run a benchmark after startup and exit, \"list\" to show them\n");
+}
+
+int main(int argc, char *argv[]) {
+  static const option long_options[] = {
+    { "virtual-time", no_argument,       nullptr, 'v' },
+    { "batch",        required_argument, nullptr, 'b' },
+    { "summary",      required_argument, nullptr, 'o' },
+    { "time-limit",   required_argument, nullptr, 't' },
+    { "step-cycles",  required_argument, nullptr, 's' },
+    { "quiet",        no_argument,       nullptr, 'q' },
+    { "benchmark",    required_argument, nullptr, 'B' },
+    { "help",         no_argument,       nullptr, 'h' },
+    { nullptr, 0, nullptr, 0 }
+  };
+  bool virtual_time = false, quiet = false;
+  const char *benchmark = nullptr;
+  for (int opt; (opt = getopt_long(argc, argv, "vb:o:t:s:qB:h", long_options, nullptr)) != -1;) {
+    switch (opt) {
+      case 'v': virtual_time = true; break;
+      case 'b': batch.gcode_path = optarg; break;
+      case 'o': batch.summary_path = optarg; break;
+      case 't': batch.time_limit = uint64_t(atof(optarg) * 1e9); break;
+      case 's': LinearAxis::step_cycles = atoi(optarg); break;
+      case 'q': quiet = true; break;
+      case 'B': benchmark = optarg; break;
+      case 'h': usage(argv[0]); return 0;
+      default:  usage(argv[0]); return 1;
+    }
+  }
+
+  if (batch.gcode_path) {
+    batch.gcode = fopen(batch.gcode_path, "rb");
+    if (!batch.gcode) { perror(batch.gcode_path); return 1; }
+    virtual_time = true;
+    serial_out = quiet ? nullptr : stderr;
+  }
+
+  // Benchmarks keep time standing still and stdout to themselves
+  if (benchmark) {
+    virtual_time = true;
+    serial_out = quiet ? nullptr : stderr;
+  }
+
+  // Select the time base before anything reads the Clock
+  Clock::setVirtualTime(virtual_time);
+
   std::thread write_serial (write_serial_thread);
-  std::thread read_serial (read_serial_thread);
+  std::thread read_serial;
+  if (!batch.active()) read_serial = std::thread(read_serial_thread);
 
   #ifdef MYSERIAL1
     MYSERIAL1.begin(BAUDRATE);
@@ -120,19 +406,44 @@ int main() {
 
   HAL_timer_init();
 
-  std::thread simulation (simulation_loop);
+  std::thread simulation;
+  if (virtual_time) {
+    machine = new SimulatedMachine();
+    simulation_timer.init(2, SIMULATION_TIMER_RATE, simulation_isr);
+    simulation_timer.start(SIMULATION_TIMER_FREQUENCY);
+    simulation_timer.enable();
+  }
+  else
+    simulation = std::thread(simulation_loop);
 
   DELAY_US(10000);
 
   setup();
+
+  if (benchmark) {
+    const int status = run_benchmark(benchmark);
+    fflush(stdout);
+    if (serial_out) fflush(serial_out);
+    _exit(status);
+  }
+
+  if (batch.active()) {
+    batch.begin();
+    for (;;) {
+      batch.feed();
+      loop();
+      if (batch.finished()) batch.finish(true);
+    }
+  }
+
   for (;;) {
     loop();
     std::this_thread::yield();
   }
 
-  simulation.join();
+  if (simulation.joinable()) simulation.join();
   write_serial.join();
-  read_serial.join();
+  if (read_serial.joinable()) read_serial.join();
 }
 
 #endif // __PLAT_LINUX__
@@ -102,6 +102,11 @@ void calibrate_delay_loop();
   // Teensy compiler is too old and does not accept smart delay compile-time / run-time selection correctly
   #define DELAY_US(x) DelayCycleFnc((x) * ((F_CPU) / 1000000UL))
 
+  // The DWT cycle counter, for timing code. Started by calibrate_delay_loop() on Cortex-M3 and up.
+  #if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+    #define HAL_CYCLE_COUNT() (*(volatile uint32_t *)0xE0001004)
+  #endif
+
 #elif defined(__AVR__)
   FORCE_INLINE static void __delay_up_to_3c(uint8_t cycles) {
     switch (cycles) {
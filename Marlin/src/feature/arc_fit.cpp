@@ -0,0 +1,151 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * arc_fit.cpp - Replace runs of G1 moves along a circle with one arc
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(ARC_FITTING)
+
+#include "arc_fit.h"
+
+ArcFit arc_fit;
+
+#include "../module/motion.h"
+#include "../module/planner.h"
+
+#if ENABLED(CNC_WORKSPACE_PLANES)
+  #include "../gcode/gcode.h"
+#endif
+
+// G2_G3.cpp
+void plan_arc(const xyze_pos_t &cart, const ab_float_t &offset, const bool clockwise, const uint8_t circles);
+
+xyze_pos_t ArcFit::start;
+xyze_pos_t ArcFit::point[ARC_FIT_MAX_POINTS];
+uint8_t ArcFit::count; // = 0
+feedRate_t ArcFit::feedrate;
+float ArcFit::e_per_mm;
+xy_pos_t ArcFit::center;
+bool ArcFit::clockwise;
+
+/**
+ * Can the held run be extended to 'end'? The circle through the start,
+ * the middle and the new end of the run must pass within ARC_FIT_TOLERANCE
+ * of every held point, and the run must go one way around it, by less than
+ * a whole turn.
+ */
+bool ArcFit::fits(const xyze_pos_t &end) {
+  // Circle through the start, the middle and the end
+  const xy_pos_t b = xy_pos_t(point[count / 2]) - start,
+                 c = xy_pos_t(end) - start;
+  const float d = 2 * (b.x * c.y - b.y * c.x);
+  if (ABS(d) < 1e-6f) return false;                 // In a line
+
+  const float bb = b.x * b.x + b.y * b.y, cc = c.x * c.x + c.y * c.y;
+  const xy_pos_t r0 = { -(c.y * bb - b.y * cc) / d, -(b.x * cc - c.x * bb) / d }; // Center to start
+  const float radius = r0.magnitude();
+  if (radius > ARC_FIT_MAX_RADIUS) return false;
+
+  const xy_pos_t ctr = xy_pos_t(start) - r0;
+  const bool cw = d < 0;
+
+  // Every point on the circle, each one further around the same way
+  xy_pos_t prev = r0;
+  float angle = 0;
+  LOOP_L_N(i, count + 1) {
+    const xy_pos_t r = xy_pos_t(i < count ? point[i] : end) - ctr;
+    if (ABS(r.magnitude() - radius) > ARC_FIT_TOLERANCE) return false;
+    const float cross = prev.x * r.y - prev.y * r.x,
+                dot = prev.x * r.x + prev.y * r.y;
+    if ((cw ? -cross : cross) <= 0 || dot <= 0) return false;
+    angle += ATAN2(ABS(cross), dot);
+    prev = r;
+  }
+  if (angle > RADIANS(355)) return false;
+
+  center = ctr;
+  clockwise = cw;
+  return true;
+}
+
+bool ArcFit::hold_line_to_destination() {
+  const float length = HYPOT(destination.x - current_position.x, destination.y - current_position.y);
+
+  // Only short XY moves in the XY plane can be part of an arc
+  bool ok = WITHIN(length, 0.001f, float(ARC_FIT_MAX_LENGTH))
+            && TERN1(CNC_WORKSPACE_PLANES, gcode.workspace_plane == GcodeSuite::PLANE_XY);
+  LOOP_S_L_N(a, Z_AXIS, LINEAR_AXES) if (destination[a] != current_position[a]) ok = false;
+  if (!ok) {
+    flush();
+    return false;
+  }
+
+  const float e_mm = TERN0(HAS_EXTRUDERS, (destination.e - current_position.e) / length);
+
+  if (count && !(count < ARC_FIT_MAX_POINTS
+    && feedrate_mm_s == feedrate
+    && ABS(e_mm - e_per_mm) <= ABS(e_per_mm) * (ARC_FIT_E_RATIO_TOLERANCE)
+    && fits(destination)
+  )) flush();
+
+  if (!count) {
+    // Start a new run with this move
+    start = current_position;
+    feedrate = feedrate_mm_s;
+    e_per_mm = e_mm;
+  }
+
+  point[count++] = destination;
+  current_position = destination;
+  return true;
+}
+
+void ArcFit::flush() {
+  if (!count) return;
+  const uint8_t n = count;
+  count = 0;
+
+  // Plan from the start of the run to its end, which is current_position
+  const xyze_pos_t dest = destination;
+  const feedRate_t old_feedrate = feedrate_mm_s;
+  current_position = start;
+  feedrate_mm_s = feedrate;
+  if (n >= ARC_FIT_MIN_POINTS)
+    plan_arc(point[n - 1], center - start, clockwise, 0);
+  else {
+    LOOP_L_N(i, n) {
+      destination = point[i];
+      prepare_line_to_destination();
+    }
+  }
+  feedrate_mm_s = old_feedrate;
+  destination = dest;
+}
+
+void ArcFit::idle() {
+  if (count && planner.movesplanned() < (BLOCK_BUFFER_SIZE) / 2) flush();
+}
+
+#endif // ARC_FITTING
@@ -0,0 +1,66 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * arc_fit.h - Replace runs of G1 moves along a circle with one arc
+ *
+ * Short XY moves are held back while their end points stay on a common
+ * circle. When the run ends it's planned with plan_arc(), the same as a
+ * G2/G3, or as the original lines if it's too short to be worth an arc.
+ *
+ * While moves are held, current_position is the end of the held run and
+ * the planner position is still at its start.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+#include "../core/types.h"
+
+class ArcFit {
+private:
+  static xyze_pos_t start;                    // Where the held run begins
+  static xyze_pos_t point[ARC_FIT_MAX_POINTS]; // End of each held move
+  static uint8_t count;                       // Number of held moves
+  static feedRate_t feedrate;                 // Feedrate of the held run
+  static float e_per_mm;                      // Extrusion per mm of the held run
+  static xy_pos_t center;                     // Center of the circle through the held run
+  static bool clockwise;                      // Direction of the held run around the center
+
+  static bool fits(const xyze_pos_t &end);
+
+public:
+  static bool has_moves() { return count > 0; }
+
+  // Hold the G1 to destination, or give back 'false' to have it planned as usual
+  static bool hold_line_to_destination();
+
+  // Plan the held moves as an arc, or as lines if there are too few
+  static void flush();
+
+  // Forget the held moves after a quick stop
+  static void discard() { count = 0; }
+
+  // Plan the held moves if the planner is running low on moves
+  static void idle();
+};
+
+extern ArcFit arc_fit;
@@ -40,9 +40,10 @@ float         Mixer::collector[MIXING_STEPPERS]; // mix proportion. 0.0 = off, o
 mixer_comp_t  Mixer::color[NR_MIXING_VIRTUAL_TOOLS][MIXING_STEPPERS];
 
 // Used in Stepper
-int_fast8_t   Mixer::runner = 0;
 mixer_comp_t  Mixer::s_color[MIXING_STEPPERS];
+mixer_accu_t  Mixer::s_total = 1;
 mixer_accu_t  Mixer::accu[MIXING_STEPPERS] = { 0 };
+mixer_mask_t  Mixer::s_mask = 0;
 
 #if EITHER(HAS_DUAL_MIXING, GRADIENT_MIX)
   mixer_perc_t Mixer::mix[MIXING_STEPPERS];
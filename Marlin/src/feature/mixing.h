@@ -28,19 +28,20 @@
 #ifndef __AVR__ // || HAS_DUAL_MIXING
   // Use 16-bit (or fastest) data for the integer mix factors
   typedef uint_fast16_t mixer_comp_t;
-  typedef uint_fast16_t mixer_accu_t;
+  typedef uint_fast32_t mixer_accu_t;   // Holds the sum of all the mix factors
   #define COLOR_A_MASK 0x8000
   #define COLOR_MASK 0x7FFF
 #else
   // Use 8-bit data for the integer mix factors
   // Exactness is sacrificed for speed
-  #define MIXER_ACCU_SIGNED
   typedef uint8_t mixer_comp_t;
-  typedef int8_t mixer_accu_t;
+  typedef uint16_t mixer_accu_t;
   #define COLOR_A_MASK 0x80
   #define COLOR_MASK 0x7F
 #endif
 
+typedef uint8_t mixer_mask_t;           // One bit per mixing stepper
+
 typedef int8_t mixer_perc_t;
 
 #ifndef MIXING_VIRTUAL_TOOLS
@@ -119,7 +120,16 @@ class Mixer {
   }
 
   FORCE_INLINE static void stepper_setup(mixer_comp_t b_color[MIXING_STEPPERS]) {
-    MIXER_STEPPER_LOOP(i) s_color[i] = b_color[i];
+    bool same = true;
+    mixer_accu_t total = 0;
+    MIXER_STEPPER_LOOP(i) {
+      if (s_color[i] != b_color[i]) { s_color[i] = b_color[i]; same = false; }
+      total += b_color[i];
+    }
+    s_total = _MAX(total, mixer_accu_t(1));
+    // Blocks of the same mix carry on where the last one left off.
+    // A new mix starts each stepper half a step in, to round its steps.
+    if (!same) MIXER_STEPPER_LOOP(i) accu[i] = s_total / 2;
   }
 
   #if EITHER(HAS_DUAL_MIXING, GRADIENT_MIX)
@@ -228,23 +238,36 @@ class Mixer {
 
   #endif // GRADIENT_MIX
 
-  // Used in Stepper
-  FORCE_INLINE static uint8_t get_stepper() { return runner; }
-  FORCE_INLINE static uint8_t get_next_stepper() {
-    for (;;) {
-      if (--runner < 0) runner = MIXING_STEPPERS - 1;
-      accu[runner] += s_color[runner];
-      if (
-        #ifdef MIXER_ACCU_SIGNED
-          accu[runner] < 0
-        #else
-          accu[runner] & COLOR_A_MASK
-        #endif
-      ) {
-        accu[runner] &= COLOR_MASK;
-        return runner;
+  /**
+   * Used in Stepper
+   *
+   * Each mixing stepper runs its own Bresenham DDA at the rate of the E axis.
+   * For every E step it adds its share of the mix and steps when that adds up
+   * to a whole step, so each stepper gets an even step rate of its own and
+   * several steppers may step together.
+   *
+   * Reverse E steps run the DDAs backwards, so the steppers that take back a
+   * step (e.g., a Linear Advance step) are the same ones that took it.
+   */
+  FORCE_INLINE static mixer_mask_t get_steppers() { return s_mask; }
+  FORCE_INLINE static mixer_mask_t get_next_steppers(const bool forward=true) {
+    mixer_mask_t mask = 0;
+    MIXER_STEPPER_LOOP(i) {
+      if (forward) {
+        accu[i] += s_color[i];
+        if (accu[i] >= s_total) {
+          accu[i] -= s_total;
+          SBI(mask, i);
+        }
+      }
+      else if (accu[i] < s_color[i]) {
+        accu[i] += s_total - s_color[i];
+        SBI(mask, i);
       }
+      else
+        accu[i] -= s_color[i];
     }
+    return (s_mask = mask);
   }
 
   private:
@@ -254,9 +277,10 @@ class Mixer {
   static mixer_comp_t color[NR_MIXING_VIRTUAL_TOOLS][MIXING_STEPPERS];
 
   // Used in Stepper
-  static int_fast8_t  runner;
   static mixer_comp_t s_color[MIXING_STEPPERS];
+  static mixer_accu_t s_total;                // Sum of s_color, one whole step for each DDA
   static mixer_accu_t accu[MIXING_STEPPERS];
+  static mixer_mask_t s_mask;                 // The steppers stepped by the last E step
 };
 
 extern Mixer mixer;
@@ -0,0 +1,120 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * segment_merge.cpp - Join runs of short, collinear G1 moves into one move
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SEGMENT_MERGE)
+
+#include "segment_merge.h"
+
+SegmentMerge segment_merge;
+
+#include "../module/motion.h"
+#include "../module/planner.h"
+
+xyze_pos_t SegmentMerge::start;
+xyz_pos_t SegmentMerge::point[SEGMENT_MERGE_MAX_POINTS];
+uint8_t SegmentMerge::count; // = 0
+feedRate_t SegmentMerge::feedrate;
+float SegmentMerge::e_per_mm;
+
+/**
+ * Can the held run be extended to 'end', extruding 'e_mm' per mm?
+ * All the held points must be within SEGMENT_MERGE_TOLERANCE of the
+ * straight line from the start of the run to the new end.
+ */
+bool SegmentMerge::fits(const xyz_pos_t &end, const float e_mm) {
+  if (count >= SEGMENT_MERGE_MAX_POINTS) return false;
+  if (feedrate_mm_s != feedrate) return false;
+  if (ABS(e_mm - e_per_mm) > ABS(e_per_mm) * (SEGMENT_MERGE_E_RATIO_TOLERANCE)) return false;
+
+  xyz_pos_t chord = end;
+  chord -= start;
+  float chord_sq = 0;
+  LOOP_LINEAR_AXES(a) chord_sq += sq(chord[a]);
+
+  LOOP_L_N(i, count) {
+    xyz_pos_t w = point[i];
+    w -= start;
+    float dot = 0;
+    LOOP_LINEAR_AXES(a) dot += w[a] * chord[a];
+    const float t = constrain(dot / chord_sq, 0.0f, 1.0f);
+    float dist_sq = 0;
+    LOOP_LINEAR_AXES(a) dist_sq += sq(w[a] - t * chord[a]);
+    if (dist_sq > sq(float(SEGMENT_MERGE_TOLERANCE))) return false;
+  }
+  return true;
+}
+
+bool SegmentMerge::hold_line_to_destination() {
+  // Length of the move and its extrusion per mm
+  float length_sq = 0;
+  LOOP_LINEAR_AXES(a) length_sq += sq(destination[a] - current_position[a]);
+  const float length = SQRT(length_sq);
+
+  // Only short moves with some XYZ motion are worth holding
+  if (!WITHIN(length, 0.001f, float(SEGMENT_MERGE_MAX_LENGTH))) {
+    flush();
+    return false;
+  }
+
+  const float e_mm = TERN0(HAS_EXTRUDERS, (destination.e - current_position.e) / length);
+  const xyz_pos_t end = destination;
+
+  if (count && !fits(end, e_mm)) flush();
+
+  if (!count) {
+    // Start a new run with this move
+    start = current_position;
+    feedrate = feedrate_mm_s;
+    e_per_mm = e_mm;
+  }
+
+  point[count++] = end;
+  current_position = destination;
+  return true;
+}
+
+void SegmentMerge::flush() {
+  if (!count) return;
+  count = 0;
+
+  // Plan a line from the start of the run to its end, which is current_position
+  const xyze_pos_t dest = destination;
+  const feedRate_t old_feedrate = feedrate_mm_s;
+  destination = current_position;
+  current_position = start;
+  feedrate_mm_s = feedrate;
+  prepare_line_to_destination();
+  feedrate_mm_s = old_feedrate;
+  destination = dest;
+}
+
+void SegmentMerge::idle() {
+  if (count && planner.movesplanned() < (BLOCK_BUFFER_SIZE) / 2) flush();
+}
+
+#endif // SEGMENT_MERGE
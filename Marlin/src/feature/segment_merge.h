@@ -0,0 +1,64 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * segment_merge.h - Join runs of short, collinear G1 moves into one move
+ *
+ * A G1 that may be joined with the next one is held back instead of being
+ * planned. The held run of moves is given to the planner as a single line
+ * as soon as a move doesn't fit on it, or any other command is processed.
+ *
+ * While moves are held, current_position is the end of the held run and
+ * the planner position is still at its start.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+#include "../core/types.h"
+
+class SegmentMerge {
+private:
+  static xyze_pos_t start;                          // Where the held run begins
+  static xyz_pos_t point[SEGMENT_MERGE_MAX_POINTS]; // End of each held move
+  static uint8_t count;                             // Number of held moves
+  static feedRate_t feedrate;                       // Feedrate of the held run
+  static float e_per_mm;                            // Extrusion per mm of the held run
+
+  static bool fits(const xyz_pos_t &end, const float e_mm);
+
+public:
+  static bool has_moves() { return count > 0; }
+
+  // Hold the G1 to destination, or give back 'false' to have it planned as usual
+  static bool hold_line_to_destination();
+
+  // Plan the held moves as one line
+  static void flush();
+
+  // Forget the held moves after a quick stop
+  static void discard() { count = 0; }
+
+  // Plan the held moves if the planner is running low on moves
+  static void idle();
+};
+
+extern SegmentMerge segment_merge;
@@ -316,6 +316,16 @@ void GcodeSuite::G28() {
     motion_state_t saved_motion_state = begin_slow_homing();
   #endif
 
+  // Home without input shaping, so the axes stop right where the endstops trigger
+  #if ENABLED(INPUT_SHAPING_X)
+    const shaping_params_t saved_shaping_x = input_shaping.x.params;
+    stepper.set_shaping_params(X_AXIS, { saved_shaping_x.type, 0, saved_shaping_x.zeta });
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    const shaping_params_t saved_shaping_y = input_shaping.y.params;
+    stepper.set_shaping_params(Y_AXIS, { saved_shaping_y.type, 0, saved_shaping_y.zeta });
+  #endif
+
   // Always home with tool 0 active
   #if HAS_MULTI_HOTEND
     #if DISABLED(DELTA) || ENABLED(DELTA_HOME_TO_SAFE_ZONE)
@@ -501,6 +511,9 @@ void GcodeSuite::G28() {
 
   restore_feedrate_and_scaling();
 
+  TERN_(INPUT_SHAPING_X, stepper.set_shaping_params(X_AXIS, saved_shaping_x));
+  TERN_(INPUT_SHAPING_Y, stepper.set_shaping_params(Y_AXIS, saved_shaping_y));
+
   // Restore the active tool after homing
   #if HAS_MULTI_HOTEND && (DISABLED(DELTA) || ENABLED(DELTA_HOME_TO_SAFE_ZONE))
     tool_change(old_tool_index, TERN(PARKING_EXTRUDER, !pe_final_change_must_unpark, DISABLED(DUAL_X_CARRIAGE)));   // Do move if one of these
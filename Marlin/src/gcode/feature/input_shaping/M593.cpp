@@ -0,0 +1,87 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "../../../inc/MarlinConfig.h"
+
+#if HAS_SHAPING
+
+#include "../../gcode.h"
+#include "../../../module/stepper.h"
+
+void GcodeSuite::M593_report(const bool forReplay/*=true*/) {
+  report_heading(forReplay, F(STR_INPUT_SHAPING));
+  auto report_axis = [&](const char axis, const shaping_params_t &p) {
+    report_echo_start(forReplay);
+    SERIAL_ECHOLNPGM("  M593 ", AS_CHAR(axis), " T", int(p.type), " F", p.frequency, " D", p.zeta);
+  };
+  TERN_(INPUT_SHAPING_X, report_axis('X', input_shaping.x.params));
+  TERN_(INPUT_SHAPING_Y, report_axis('Y', input_shaping.y.params));
+}
+
+/**
+ * M593: Get or set input shaping parameters
+ *
+ *  X           Set only the X axis
+ *  Y           Set only the Y axis
+ *  T<type>     Shaper type: 0 = ZV, 1 = ZVD, 2 = MZV
+ *  F<hz>       Resonant frequency, or 0 to disable shaping
+ *  D<zeta>     Damping ratio (0.0 - 0.99)
+ *
+ * Without T, F or D report the current settings.
+ */
+void GcodeSuite::M593() {
+  if (!parser.seen("TFD")) return M593_report();
+
+  if (parser.seenval('T') && !WITHIN(parser.value_int(), SHAPER_ZV, SHAPER_MZV)) {
+    SERIAL_ECHOLNPGM("?T must be 0 (ZV), 1 (ZVD) or 2 (MZV).");
+    return;
+  }
+  if (parser.seenval('F')) {
+    const float f = parser.value_float();
+    if (f != 0 && !(f >= SHAPING_MIN_FREQ)) {
+      SERIAL_ECHOLNPGM("?F must be 0 or at least ", SHAPING_MIN_FREQ, " (SHAPING_MIN_FREQ).");
+      return;
+    }
+  }
+  if (parser.seenval('D') && !WITHIN(parser.value_float(), 0, 0.99f)) {
+    SERIAL_ECHOLNPGM("?D must be from 0 to 0.99.");
+    return;
+  }
+
+  auto set_axis = [](const AxisEnum axis, shaping_params_t p) {
+    if (parser.seenval('T')) p.type = ShaperType(parser.value_int());
+    if (parser.seenval('F')) p.frequency = parser.value_float();
+    if (parser.seenval('D')) p.zeta = parser.value_float();
+    stepper.set_shaping_params(axis, p);
+  };
+
+  const bool seen_x = parser.seen_test('X'), seen_y = parser.seen_test('Y');
+  #if ENABLED(INPUT_SHAPING_X)
+    if (seen_x || !seen_y) set_axis(X_AXIS, input_shaping.x.params);
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    if (seen_y || !seen_x) set_axis(Y_AXIS, input_shaping.y.params);
+  #endif
+}
+
+#endif // HAS_SHAPING
@@ -69,6 +69,12 @@ GcodeSuite gcode;
   #include "../feature/fancheck.h"
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  #include "../feature/segment_merge.h"
+#elif ENABLED(ARC_FITTING)
+  #include "../feature/arc_fit.h"
+#endif
+
 #include "../MarlinCore.h" // for idle, kill
 
 // Inactivity shutdown
@@ -323,6 +329,14 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
     }
   #endif
 
+  #if EITHER(SEGMENT_MERGE, ARC_FITTING)
+    // Held G1 moves are planned before any other command runs
+    if (!(parser.command_letter == 'G' && parser.codenum <= 1)) {
+      TERN_(SEGMENT_MERGE, segment_merge.flush());
+      TERN_(ARC_FITTING, arc_fit.flush());
+    }
+  #endif
+
   // Handle a known command or reply "unknown command"
 
   switch (parser.command_letter) {
@@ -891,6 +905,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if HAS_SHAPING
+        case 593: M593(); break;                                  // M593: Set input shaping parameters
+      #endif
+
       #if ENABLED(ADVANCED_PAUSE_FEATURE)
         case 600: M600(); break;                                  // M600: Pause for Filament Change
         case 603: M603(); break;                                  // M603: Configure Filament Change
@@ -1095,17 +1113,37 @@ void GcodeSuite::process_next_command() {
 
   TERN_(POWER_LOSS_RECOVERY, recovery.queue_index_r = queue.ring_buffer.index_r);
 
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    const GCodeParser::preparsed_t * const preparsed = queue.ring_buffer.peek_next_preparsed();
+  #endif
+
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
-    SERIAL_ECHOLN(command.buffer);
+    #if ENABLED(PREPARSED_GCODE_QUEUE)
+      if (preparsed) {
+        SERIAL_ECHOPGM("G", preparsed->codenum);
+        LOOP_L_N(i, preparsed->count) {
+          SERIAL_CHAR(' ', preparsed->letter[i]);
+          SERIAL_DECIMAL(preparsed->value[i]);
+        }
+        SERIAL_EOL();
+      }
+      else
+    #endif
+        SERIAL_ECHOLN(command.buffer);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPGM("slot:", queue.ring_buffer.index_r);
       M100_dump_routine(F("   Command Queue:"), (const char*)&queue.ring_buffer, sizeof(queue.ring_buffer));
     #endif
   }
 
-  // Parse the next command in the queue
-  parser.parse(command.buffer);
+  // Parse the next command in the queue, or load the move parsed as it was queued
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    if (preparsed)
+      parser.load(*preparsed);
+    else
+  #endif
+      parser.parse(command.buffer);
   process_parsed_command();
 }
 
@@ -1121,6 +1159,7 @@ void GcodeSuite::process_next_command() {
 void GcodeSuite::process_subcommands_now(FSTR_P fgcode) {
   PGM_P pgcode = FTOP(fgcode);
   char * const saved_cmd = parser.command_ptr;        // Save the parser state
+  TERN_(PREPARSED_GCODE_QUEUE, const GCodeParser::preparsed_t * const saved_move = parser.preparsed);
   for (;;) {
     PGM_P const delim = strchr_P(pgcode, '\n');       // Get address of next newline
     const size_t len = delim ? delim - pgcode : strlen_P(pgcode); // Get the command length
@@ -1132,13 +1171,19 @@ void GcodeSuite::process_subcommands_now(FSTR_P fgcode) {
     if (!delim) break;                                // Last command?
     pgcode = delim + 1;                               // Get the next command
   }
-  parser.parse(saved_cmd);                            // Restore the parser state
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    if (saved_move)
+      parser.load(*saved_move);                      // Restore a pre-parsed move
+    else
+  #endif
+      parser.parse(saved_cmd);                       // Restore the parser state
 }
 
 #pragma GCC diagnostic pop
 
 void GcodeSuite::process_subcommands_now(char * gcode) {
   char * const saved_cmd = parser.command_ptr;        // Save the parser state
+  TERN_(PREPARSED_GCODE_QUEUE, const GCodeParser::preparsed_t * const saved_move = parser.preparsed);
   for (;;) {
     char * const delim = strchr(gcode, '\n');         // Get address of next newline
     if (delim) *delim = '\0';                         // Replace with nul
@@ -1148,7 +1193,12 @@ void GcodeSuite::process_subcommands_now(char * gcode) {
     *delim = '\n';                                    // Put back the newline
     gcode = delim + 1;                                // Get the next command
   }
-  parser.parse(saved_cmd);                            // Restore the parser state
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    if (saved_move)
+      parser.load(*saved_move);                      // Restore a pre-parsed move
+    else
+  #endif
+      parser.parse(saved_cmd);                       // Restore the parser state
 }
 
 #if ENABLED(HOST_KEEPALIVE_FEATURE)
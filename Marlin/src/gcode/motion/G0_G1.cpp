@@ -35,6 +35,12 @@
   #include "../../module/stepper.h"
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  #include "../../feature/segment_merge.h"
+#elif ENABLED(ARC_FITTING)
+  #include "../../feature/arc_fit.h"
+#endif
+
 extern xyze_pos_t destination;
 
 #if ENABLED(VARIABLE_G0_FEEDRATE)
@@ -103,6 +109,13 @@ void GcodeSuite::G0_G1(TERN_(HAS_FAST_MOVES, const bool fast_move/*=false*/)) {
 
     #endif // FWRETRACT
 
+    #if ENABLED(SEGMENT_MERGE)
+      // Hold a G1 to join it with the next ones. G0 and other moves are planned as usual.
+      if (TERN0(HAS_FAST_MOVES, fast_move) || !segment_merge.hold_line_to_destination())
+    #elif ENABLED(ARC_FITTING)
+      // Hold a G1 that may be part of an arc. G0 and other moves are planned as usual.
+      if (TERN0(HAS_FAST_MOVES, fast_move) || !arc_fit.hold_line_to_destination())
+    #endif
     #if IS_SCARA
       fast_move ? prepare_fast_move_to_destination() : prepare_line_to_destination();
     #else
@@ -121,6 +134,8 @@ void GcodeSuite::G0_G1(TERN_(HAS_FAST_MOVES, const bool fast_move/*=false*/)) {
         #define _MOVE_SYNC parser.seenval('Z')  // Only for Z move
       #endif
       if (_MOVE_SYNC) {
+        TERN_(SEGMENT_MERGE, segment_merge.flush());
+        TERN_(ARC_FITTING, arc_fit.flush());
         planner.synchronize();
         SERIAL_ECHOLNPGM(STR_Z_MOVE_COMP);
       }
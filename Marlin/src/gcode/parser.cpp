@@ -66,6 +66,10 @@ uint16_t GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if ENABLED(PREPARSED_GCODE_QUEUE)
+  const GCodeParser::preparsed_t *GCodeParser::preparsed; // = nullptr
+#endif
+
 // Create a global instance of the GCode parser singleton
 GCodeParser parser;
 
@@ -80,6 +84,7 @@ void GCodeParser::reset() {
   command_letter = '?';                 // No command letter
   codenum = 0;                          // No command code
   TERN_(USE_GCODE_SUBCODES, subcode = 0); // No command sub-code
+  TERN_(PREPARSED_GCODE_QUEUE, preparsed = nullptr); // Not a pre-parsed move
   #if ENABLED(FASTER_GCODE_PARSER)
     codebits = 0;                       // No codes yet
     //ZERO(param);                      // No parameters (should be safe to comment out this line)
@@ -363,6 +368,125 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+/**
+ * Convert a G-code number to float, stopping at the first character that
+ * isn't part of it. Slicer numbers have few digits, so when the digits fit
+ * in 24 bits with no more than 10 decimals, both the digits and the power
+ * of 10 are exact floats and one divide gives the same correctly rounded
+ * result as strtof(). Anything longer, or hex, still goes to strtof().
+ */
+float GCodeParser::parse_float(char * const str) {
+  static const float pow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+  const char *p = str;
+  const bool neg = *p == '-';
+  if (neg || *p == '+') ++p;
+
+  uint32_t digits = 0;
+  uint8_t decimals = 0, zeros = 0;
+  bool point = false, exact = true;
+
+  auto add_digit = [&](const uint8_t d) {
+    digits = digits * 10 + d;
+    decimals += point;
+    return digits <= _BV32(24) && decimals < COUNT(pow10);
+  };
+
+  for (;; ++p) {
+    const char c = *p;
+    if (c == '.' && !point) { point = true; continue; }
+    if (!NUMERIC(c)) break;
+    if (point && c == '0') { ++zeros; continue; } // Trailing zeros change nothing
+    for (; zeros && exact; --zeros) exact = add_digit(0);
+    if (!exact || !(exact = add_digit(c - '0'))) break;
+  }
+
+  if (exact && *p != 'x' && *p != 'X') {
+    const float f = decimals ? float(digits) / pow10[decimals] : float(digits);
+    return neg ? -f : f;
+  }
+
+  // Cut off any exponent and leave it to strtof()
+  for (char *e = str; *e && *e != ' '; ++e) {
+    const char c = *e;
+    if (c == 'E' || c == 'e') {
+      *e = '\0';
+      const float ret = strtof(str, nullptr);
+      *e = c;
+      return ret;
+    }
+  }
+  return strtof(str, nullptr);
+}
+
+#if ENABLED(PREPARSED_GCODE_QUEUE)
+
+  /**
+   * Parse a plain G0-G3 move into its parameter letters and values.
+   * Lines that parse() might read in any other way are left as text:
+   * a line number or checksum, lowercase, a parameter with no value,
+   * or a value not followed by a space or the next parameter. Values come
+   * from parse_float(), the same as value_float(), so the move is exactly
+   * the same as when it's parsed from text.
+   */
+  bool GCodeParser::preparse(char *p, preparsed_t &cmd) {
+    while (*p == ' ') ++p;
+    if (*p++ != 'G' || !NUMERIC(*p)) return false;
+
+    uint8_t code = 0;
+    do {
+      code = code * 10 + *p++ - '0';
+      if (code > TERN(ARC_SUPPORT, 3, 1)) return false;
+    } while (NUMERIC(*p));
+    if (*p && *p != ' ' && !WITHIN(*p, 'A', 'Z')) return false;
+
+    cmd.codenum = code;
+    cmd.count = 0;
+    uint32_t bits = 0;
+    for (;;) {
+      while (*p == ' ') ++p;
+      const char param = *p++;
+      if (!param) return true;
+      if (!WITHIN(param, 'A', 'Z') || TEST32(bits, LETTER_BIT(param)) || cmd.count >= PREPARSED_MAX_PARAMS) return false;
+
+      while (*p == ' ') ++p;
+      if (!valid_float(p)) return false;
+
+      char *next = p;
+      while (*next && DECIMAL_SIGNED(*next)) ++next;  // Where parse() goes on
+      if (*next && *next != ' ' && !WITHIN(*next, 'A', 'Z')) return false;
+
+      SBI32(bits, LETTER_BIT(param));
+      cmd.letter[cmd.count] = param;
+      cmd.value[cmd.count++] = parse_float(p);
+      p = next;
+    }
+  }
+
+  void GCodeParser::load(const preparsed_t &cmd) {
+    static char gcode_str[] = "G0";
+
+    reset();
+    preparsed = &cmd;
+    gcode_str[1] = '0' + cmd.codenum;
+    command_ptr = gcode_str;
+    command_letter = 'G';
+    codenum = cmd.codenum;
+
+    #if ENABLED(GCODE_MOTION_MODES)
+      motion_mode_codenum = codenum;
+      TERN_(USE_GCODE_SUBCODES, motion_mode_subcode = 0);
+    #endif
+
+    LOOP_L_N(i, cmd.count) {
+      const uint8_t ind = LETTER_BIT(cmd.letter[i]);
+      SBI32(codebits, ind);                     // parameter exists
+      param[ind] = i;                           // index of its value
+    }
+  }
+
+#endif // PREPARSED_GCODE_QUEUE
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
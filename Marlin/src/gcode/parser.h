@@ -97,6 +97,24 @@ public:
     FORCE_INLINE static void cancel_motion_mode() { motion_mode_codenum = -1; }
   #endif
 
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    // A G0-G3 move parsed as it was queued
+    typedef struct {
+      uint8_t codenum,                        // 0-3
+              count;                          // Number of parameters
+      char letter[PREPARSED_MAX_PARAMS];      // Parameter letters
+      float value[PREPARSED_MAX_PARAMS];      // Parameter values
+    } preparsed_t;
+
+    static const preparsed_t *preparsed;      // The loaded pre-parsed move, if any
+
+    // Parse a plain G0-G3 move ahead of time. Return false to keep it as text.
+    static bool preparse(char *p, preparsed_t &cmd);
+
+    // Populate all fields from a pre-parsed move
+    static void load(const preparsed_t &cmd);
+  #endif
+
   #if ENABLED(DEBUG_GCODE_PARSER)
     static void debug();
   #endif
@@ -147,6 +165,12 @@ public:
       if (ind >= COUNT(param)) return false; // Only A-Z
       const bool b = TEST32(codebits, ind);
       if (b) {
+        #if ENABLED(PREPARSED_GCODE_QUEUE)
+          if (preparsed) {                   // Point at the value of a pre-parsed move
+            value_ptr = (char*)&preparsed->value[param[ind]];
+            return b;
+          }
+        #endif
         if (param[ind]) {
           char * const ptr = command_ptr + param[ind];
           value_ptr = valid_number(ptr) ? ptr : nullptr;
@@ -254,29 +278,26 @@ public:
   // The value as a string
   static inline char* value_string() { return value_ptr; }
 
+  // Convert a G-code number, the same as strtof() with no exponent
+  static float parse_float(char * const str);
+
   // Float removes 'E' to prevent scientific notation interpretation
   static inline float value_float() {
-    if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
-        }
-        ++e;
-      }
-      return strtof(value_ptr, nullptr);
-    }
-    return 0;
+    #if ENABLED(PREPARSED_GCODE_QUEUE)
+      if (preparsed) return value_ptr ? *(const float*)value_ptr : 0;
+    #endif
+    return value_ptr ? parse_float(value_ptr) : 0;
   }
 
   // Code value as a long or ulong
-  static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static inline uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  static inline int32_t value_long() {
+    TERN_(PREPARSED_GCODE_QUEUE, if (preparsed) return int32_t(value_float()));
+    return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L;
+  }
+  static inline uint32_t value_ulong() {
+    TERN_(PREPARSED_GCODE_QUEUE, if (preparsed) return uint32_t(value_long()));
+    return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL;
+  }
 
   // Code value for use as time
   static inline millis_t value_millis() { return value_ulong(); }
@@ -57,12 +57,22 @@ GCodeQueue queue;
   #include "../feature/repeat.h"
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  #include "../feature/segment_merge.h"
+#elif ENABLED(ARC_FITTING)
+  #include "../feature/arc_fit.h"
+#endif
+
 // Frequently used G-code strings
 PGMSTR(G28_STR, "G28");
 
 GCodeQueue::SerialState GCodeQueue::serial_state[NUM_SERIAL] = { 0 };
 GCodeQueue::RingBuffer GCodeQueue::ring_buffer = { 0 };
 
+#if HAS_DISPLAY_COMMAND_QUEUE
+  GCodeQueue::DisplayQueue GCodeQueue::display_queue = { 0 };
+#endif
+
 #if NO_TIMEOUTS > 0
   static millis_t last_command_time = 0;
 #endif
@@ -99,9 +109,47 @@ PGM_P GCodeQueue::injected_commands_P; // = nullptr
  */
 char GCodeQueue::injected_commands[64]; // = { 0 }
 
+#if ENABLED(PREPARSED_GCODE_QUEUE)
+
+  /**
+   * Parse the command in the write slot, if it's a plain move, and add it
+   * to the last slot if that one has room for more pre-parsed moves.
+   * Otherwise keep the parsed move in the write slot, in place of the text.
+   * Return true if the move was added to the last slot.
+   */
+  bool GCodeQueue::RingBuffer::commit_preparsed(TERN_(HAS_MULTI_SERIAL, const serial_index_t serial_ind)) {
+    CommandLine &command = commands[index_w];
+    GCodeParser::preparsed_t cmd;
+    command.preparsed_count = 0;
+    if (!GCodeParser::preparse(command.buffer, cmd)) return false;
+
+    if (length) {
+      CommandLine &last = commands[(index_w ? index_w : BUFSIZE) - 1];
+      if (WITHIN(last.preparsed_count, 1, preparsed_per_slot - 1)
+        && TERN1(HAS_MULTI_SERIAL, last.port.index == serial_ind.index)
+      ) {
+        last.preparsed[last.preparsed_count++] = cmd;
+        return true;
+      }
+    }
+
+    command.preparsed[0] = cmd;
+    command.preparsed_count = 1;
+    return false;
+  }
+
+#endif
+
 void GCodeQueue::RingBuffer::commit_command(bool skip_ok
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
 ) {
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    // Only commands that need no "ok" are pre-parsed, so each slot gets at most one "ok"
+    if (!skip_ok || TERN0(SDSUPPORT, card.flag.saving))
+      commands[index_w].preparsed_count = 0;
+    else if (commit_preparsed(TERN_(HAS_MULTI_SERIAL, serial_ind)))
+      return;
+  #endif
   commands[index_w].skip_ok = skip_ok;
   TERN_(HAS_MULTI_SERIAL, commands[index_w].port = serial_ind);
   TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
@@ -191,6 +239,25 @@ bool GCodeQueue::process_injected_command() {
   return true;
 }
 
+#if HAS_DISPLAY_COMMAND_QUEUE
+
+  /**
+   * Copy a display command into the display queue.
+   * Blank lines and comments are consumed without queueing.
+   */
+  bool GCodeQueue::enqueue_display(const char * const cmd) {
+    if (*cmd == 0 || ISEOL(*cmd) || *cmd == ';') return true;
+    if (display_queue.full()) return false;
+    char * const buffer = display_queue.commands[display_queue.index_w];
+    strncpy(buffer, cmd, MAX_CMD_SIZE - 1);
+    buffer[MAX_CMD_SIZE - 1] = '\0';
+    if (++display_queue.index_w >= DISPLAY_BUFSIZE) display_queue.index_w = 0;
+    display_queue.length++;
+    return true;
+  }
+
+#endif
+
 /**
  * Enqueue and return only when commands are actually enqueued.
  * Never call this from a G-code handler!
@@ -597,18 +664,46 @@ void GCodeQueue::get_serial_commands() {
 
 #endif // SDSUPPORT
 
+#if HAS_DISPLAY_COMMAND_QUEUE
+
+  /**
+   * Move one display command into the command queue. The display has no
+   * serial port of its own, so no "ok" is sent for these commands.
+   */
+  void GCodeQueue::get_display_command() {
+    if (display_queue.empty() || ring_buffer.full()) return;
+    ring_buffer.enqueue(display_queue.commands[display_queue.index_r], true OPTARG(HAS_MULTI_SERIAL, serial_index_t()));
+    if (++display_queue.index_r >= DISPLAY_BUFSIZE) display_queue.index_r = 0;
+    display_queue.length--;
+  }
+
+#endif
+
 /**
  * Add to the circular command queue the next command from:
  *  - The command-injection queues (injected_commands_P, injected_commands)
  *  - The active serial input (usually USB)
  *  - The SD card file being actively printed
+ *  - The display command queue
  */
 void GCodeQueue::get_available_commands() {
   if (ring_buffer.full()) return;
 
+  #if HAS_DISPLAY_COMMAND_QUEUE
+    // Every other call the display goes first, so a busy host or SD
+    // print can't starve it and the display can't starve them either
+    static bool display_turn; // = false
+    display_turn = !display_turn;
+    if (display_turn) get_display_command();
+  #endif
+
   get_serial_commands();
 
   TERN_(SDSUPPORT, get_sdcard_commands());
+
+  #if HAS_DISPLAY_COMMAND_QUEUE
+    if (!display_turn) get_display_command();
+  #endif
 }
 
 /**
@@ -629,6 +724,8 @@ void GCodeQueue::advance() {
 
   // Return if the G-code buffer is empty
   if (ring_buffer.empty()) {
+    TERN_(SEGMENT_MERGE, segment_merge.idle());
+    TERN_(ARC_FITTING, arc_fit.idle());
     #if ENABLED(BUFFER_MONITORING)
       if (!command_buffer_empty) {
         command_buffer_empty = true;
@@ -649,7 +746,7 @@ void GCodeQueue::advance() {
 
   #if ENABLED(SDSUPPORT)
 
-    if (card.flag.saving) {
+    if (card.flag.saving && !TERN0(PREPARSED_GCODE_QUEUE, ring_buffer.peek_next_preparsed())) {
       char * const cmd = ring_buffer.peek_next_command_string();
       if (is_M29(cmd)) {
         // M29 closes the file
@@ -685,6 +782,9 @@ void GCodeQueue::advance() {
 
   #endif // SDSUPPORT
 
+  // Stay on the slot until all of its pre-parsed moves are done
+  if (TERN0(PREPARSED_GCODE_QUEUE, ring_buffer.next_preparsed())) return;
+
   // The queue may be reset by a command handler or by code invoked by idle() within a handler
   ring_buffer.advance_pos(ring_buffer.index_r, -1);
 }
@@ -28,6 +28,10 @@
 
 #include "../inc/MarlinConfig.h"
 
+#if ENABLED(PREPARSED_GCODE_QUEUE)
+  #include "parser.h"
+#endif
+
 class GCodeQueue {
 public:
   /**
@@ -47,6 +51,15 @@ public:
 
   static SerialState serial_state[NUM_SERIAL]; //!< Serial states for each serial port
 
+  #if ENABLED(PREPARSED_GCODE_QUEUE)
+    /**
+     * Pre-parsed moves that share one command slot. Power-Loss Recovery
+     * keeps one SD position per slot, so it gets one move per slot.
+     */
+    static constexpr uint8_t preparsed_per_slot = TERN(POWER_LOSS_RECOVERY, 1, MAX_CMD_SIZE / sizeof(GCodeParser::preparsed_t));
+    static_assert(preparsed_per_slot >= 1, "MAX_CMD_SIZE is too small for PREPARSED_MAX_PARAMS.");
+  #endif
+
   /**
    * GCode Command Queue
    * A simple (circular) ring buffer of BUFSIZE command strings.
@@ -55,9 +68,18 @@ public:
    * (immediate, serial, sd card) and they are processed sequentially by
    * the main loop. The gcode.process_next_command method parses the next
    * command and hands off execution to individual handler functions.
+   * With PREPARSED_GCODE_QUEUE a slot may hold several moves parsed ahead.
    */
   struct CommandLine {
-    char buffer[MAX_CMD_SIZE];      //!< The command buffer
+    #if ENABLED(PREPARSED_GCODE_QUEUE)
+      union {
+        char buffer[MAX_CMD_SIZE];    //!< The command buffer
+        GCodeParser::preparsed_t preparsed[preparsed_per_slot]; //!< Pre-parsed moves
+      };
+      uint8_t preparsed_count;        //!< Number of pre-parsed moves, or 0 for a text command
+    #else
+      char buffer[MAX_CMD_SIZE];      //!< The command buffer
+    #endif
     bool skip_ok;                   //!< Skip sending ok when command is processed?
     #if HAS_MULTI_SERIAL
       serial_index_t port;          //!< Serial port the command was received on
@@ -71,11 +93,14 @@ public:
     uint8_t length,                 //!< Number of commands in the queue
             index_r,                //!< Ring buffer's read position
             index_w;                //!< Ring buffer's write position
+    #if ENABLED(PREPARSED_GCODE_QUEUE)
+      uint8_t preparsed_r;          //!< Next pre-parsed move in the read slot
+    #endif
     CommandLine commands[BUFSIZE];  //!< The ring buffer of commands
 
     inline serial_index_t command_port() const { return TERN0(HAS_MULTI_SERIAL, commands[index_r].port); }
 
-    inline void clear() { length = index_r = index_w = 0; }
+    inline void clear() { length = index_r = index_w = 0; TERN_(PREPARSED_GCODE_QUEUE, preparsed_r = 0); }
 
     void advance_pos(uint8_t &p, const int inc) { if (++p >= BUFSIZE) p = 0; length += inc; }
 
@@ -98,6 +123,23 @@ public:
     inline CommandLine& peek_next_command() { return commands[index_r]; }
 
     inline char* peek_next_command_string() { return peek_next_command().buffer; }
+
+    #if ENABLED(PREPARSED_GCODE_QUEUE)
+      bool commit_preparsed(TERN_(HAS_MULTI_SERIAL, const serial_index_t serial_ind));
+
+      // The next pre-parsed move, or nullptr for a text command
+      inline const GCodeParser::preparsed_t* peek_next_preparsed() {
+        CommandLine &command = peek_next_command();
+        return command.preparsed_count ? &command.preparsed[preparsed_r] : nullptr;
+      }
+
+      // Go on to the next move in the read slot. Return false when it's done.
+      inline bool next_preparsed() {
+        if (++preparsed_r < peek_next_command().preparsed_count) return true;
+        preparsed_r = 0;
+        return false;
+      }
+    #endif
   };
 
   /**
@@ -105,6 +147,30 @@ public:
    */
   static RingBuffer ring_buffer;
 
+  #if HAS_DISPLAY_COMMAND_QUEUE
+    /**
+     * Commands from a serial touch display waiting for room in the ring buffer.
+     * Filled by the UI without blocking, drained by get_available_commands().
+     */
+    struct DisplayQueue {
+      uint8_t length,                             //!< Number of commands in the queue
+              index_r,                            //!< Read position
+              index_w;                            //!< Write position
+      char commands[DISPLAY_BUFSIZE][MAX_CMD_SIZE];
+
+      inline bool full() const { return length >= DISPLAY_BUFSIZE; }
+      inline bool empty() const { return length == 0; }
+    };
+
+    static DisplayQueue display_queue;
+
+    /**
+     * Queue a command from the display. Never blocks and never calls idle(),
+     * so it is safe to use from UI code. Return false if the queue is full.
+     */
+    static bool enqueue_display(const char * const cmd);
+  #endif
+
   /**
    * Clear the Marlin command queue
    */
@@ -163,7 +229,10 @@ public:
   /**
    * Check whether there are any commands yet to be executed
    */
-  static bool has_commands_queued() { return ring_buffer.length || injected_commands_P || injected_commands[0]; }
+  static bool has_commands_queued() {
+    return ring_buffer.length || injected_commands_P || injected_commands[0]
+      || TERN0(HAS_DISPLAY_COMMAND_QUEUE, display_queue.length);
+  }
 
   /**
    * Get the next command in the queue, optionally log it to SD, then dispatch it
@@ -180,6 +249,7 @@ public:
    *  - The command-injection queue (injected_commands_P)
    *  - The active serial input (usually USB)
    *  - The SD card file being actively printed
+   *  - The display command queue
    */
   static void get_available_commands();
 
@@ -253,6 +323,10 @@ private:
     static void get_sdcard_commands();
   #endif
 
+  #if HAS_DISPLAY_COMMAND_QUEUE
+    static void get_display_command();
+  #endif
+
   // Process the next "immediate" command (PROGMEM)
   static bool process_injected_command_P();
 
@@ -494,6 +494,14 @@
   #define EXTENSIBLE_UI
 #endif
 
+// Serial touch screens that send their own G-code into the command queue
+#if ENABLED(GEEETECH_A30T_TFT)
+  #define HAS_DISPLAY_COMMAND_QUEUE 1
+  #ifndef DISPLAY_BUFSIZE
+    #define DISPLAY_BUFSIZE 4
+  #endif
+#endif
+
 // Aliases for LCD features
 #if EITHER(DWIN_CREALITY_LCD, DWIN_CREALITY_LCD_ENHANCED)
   #define HAS_DWIN_E3V2_BASIC 1
@@ -992,6 +992,23 @@
   #define HAS_USER_ITEM(N) 0
 #endif
 
+#if ENABLED(S_CURVE_ACCELERATION) && defined(S_CURVE_JERK_LIMIT)
+  #define HAS_S_CURVE_JERK_LIMIT 1
+#endif
+
+#if EITHER(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+  #define HAS_SHAPING 1
+  #ifndef SHAPING_MIN_FREQ
+    #if BOTH(INPUT_SHAPING_X, INPUT_SHAPING_Y)
+      #define SHAPING_MIN_FREQ _MIN(SHAPING_FREQ_X, SHAPING_FREQ_Y)
+    #elif ENABLED(INPUT_SHAPING_X)
+      #define SHAPING_MIN_FREQ SHAPING_FREQ_X
+    #else
+      #define SHAPING_MIN_FREQ SHAPING_FREQ_Y
+    #endif
+  #endif
+#endif
+
 #if !HAS_MULTI_SERIAL
   #undef MEATPACK_ON_SERIAL_PORT_2
 #endif
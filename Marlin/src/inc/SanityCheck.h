@@ -291,6 +291,8 @@
   #error "ADVANCE is now LIN_ADVANCE."
 #elif defined(LIN_ADVANCE_E_D_RATIO)
   #error "LIN_ADVANCE (1.5) no longer uses LIN_ADVANCE_E_D_RATIO."
+#elif defined(EXPERIMENTAL_SCURVE)
+  #error "EXPERIMENTAL_SCURVE is no longer needed and should be removed."
 #elif defined(NEOPIXEL_RGBW_LED)
   #error "NEOPIXEL_RGBW_LED is now NEOPIXEL_LED."
 #elif ENABLED(DELTA) && defined(DELTA_PROBEABLE_RADIUS)
@@ -1242,15 +1244,58 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
     WITHIN(LIN_ADVANCE_K, 0, 10),
     "LIN_ADVANCE_K must be a value from 0 to 10 (Changed in LIN_ADVANCE v1.5, Marlin 1.1.9)."
   );
-  #if ENABLED(S_CURVE_ACCELERATION) && DISABLED(EXPERIMENTAL_SCURVE)
-    #error "LIN_ADVANCE and S_CURVE_ACCELERATION may not play well together! Enable EXPERIMENTAL_SCURVE to continue."
-  #elif ENABLED(DIRECT_STEPPING)
-    #error "DIRECT_STEPPING is incompatible with LIN_ADVANCE. Enable in external planner if possible."
-  #elif NONE(HAS_JUNCTION_DEVIATION, ALLOW_LOW_EJERK) && defined(DEFAULT_EJERK)
+  #if NONE(HAS_JUNCTION_DEVIATION, ALLOW_LOW_EJERK) && defined(DEFAULT_EJERK)
     static_assert(DEFAULT_EJERK >= 10, "It is strongly recommended to set DEFAULT_EJERK >= 10 when using LIN_ADVANCE. Enable ALLOW_LOW_EJERK to bypass this alert (e.g., for direct drive).");
   #endif
 #endif
 
+/**
+ * S-Curve Acceleration - Check the jerk limit
+ */
+#if HAS_S_CURVE_JERK_LIMIT
+  static_assert(S_CURVE_JERK_LIMIT > 0, "S_CURVE_JERK_LIMIT must be greater than 0.");
+#endif
+
+/**
+ * Step interval table for 32-bit MCUs
+ */
+#if ENABLED(STEP_INTERVAL_TABLE) && !defined(CPU_32_BIT)
+  #error "STEP_INTERVAL_TABLE is only for 32-bit MCUs. AVR always uses speed_lookuptable.h."
+#endif
+
+/**
+ * Adaptive Multi-Stepping
+ */
+#if ENABLED(ADAPTIVE_MULTI_STEPPING)
+  #ifdef __AVR__
+    #error "ADAPTIVE_MULTI_STEPPING requires a cycle counter, which AVR doesn't have."
+  #elif !WITHIN(STEPPER_ISR_BUDGET, 10, 95)
+    #error "STEPPER_ISR_BUDGET must be between 10 and 95 (%)."
+  #endif
+#endif
+
+/**
+ * Input Shaping requirements
+ */
+#if HAS_SHAPING
+  #if IS_KINEMATIC || IS_CORE || EITHER(MARKFORGED_XY, MARKFORGED_YX)
+    #error "INPUT_SHAPING_[XY] requires a Cartesian machine."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "INPUT_SHAPING_[XY] is incompatible with I2S_STEPPER_STREAM."
+  #endif
+  #if ENABLED(INPUT_SHAPING_X)
+    static_assert(WITHIN(SHAPING_TYPE_X, 0, 2), "SHAPING_TYPE_X must be 0 (ZV), 1 (ZVD) or 2 (MZV).");
+    static_assert(SHAPING_FREQ_X >= SHAPING_MIN_FREQ, "SHAPING_FREQ_X must be at least SHAPING_MIN_FREQ.");
+    static_assert(WITHIN(SHAPING_ZETA_X, 0, 0.99f), "SHAPING_ZETA_X must be from 0 to 0.99.");
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    static_assert(WITHIN(SHAPING_TYPE_Y, 0, 2), "SHAPING_TYPE_Y must be 0 (ZV), 1 (ZVD) or 2 (MZV).");
+    static_assert(SHAPING_FREQ_Y >= SHAPING_MIN_FREQ, "SHAPING_FREQ_Y must be at least SHAPING_MIN_FREQ.");
+    static_assert(WITHIN(SHAPING_ZETA_Y, 0, 0.99f), "SHAPING_ZETA_Y must be from 0 to 0.99.");
+  #endif
+  static_assert(SHAPING_MIN_FREQ > 0, "SHAPING_MIN_FREQ must be greater than 0.");
+#endif
+
 /**
  * Special tool-changing options
  */
@@ -2523,6 +2568,41 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #endif
 #endif
 
+/**
+ * Segment Merge
+ */
+#if ENABLED(SEGMENT_MERGE)
+  #if !WITHIN(SEGMENT_MERGE_MAX_POINTS, 2, 255)
+    #error "SEGMENT_MERGE_MAX_POINTS must be from 2 to 255."
+  #endif
+  static_assert(SEGMENT_MERGE_TOLERANCE > 0 && SEGMENT_MERGE_MAX_LENGTH > 0, "SEGMENT_MERGE_TOLERANCE and SEGMENT_MERGE_MAX_LENGTH must be greater than 0.");
+#endif
+
+/**
+ * Arc Fitting
+ */
+#if ENABLED(ARC_FITTING)
+  #if DISABLED(ARC_SUPPORT) || ENABLED(SCARA)
+    #error "ARC_FITTING requires ARC_SUPPORT (and is not available for SCARA)."
+  #elif ENABLED(SEGMENT_MERGE)
+    #error "ARC_FITTING and SEGMENT_MERGE can't be used together."
+  #elif !WITHIN(ARC_FIT_MIN_POINTS, 3, ARC_FIT_MAX_POINTS) || ARC_FIT_MAX_POINTS > 255
+    #error "ARC_FIT_MIN_POINTS must be at least 3, and no more than ARC_FIT_MAX_POINTS (up to 255)."
+  #endif
+  static_assert(ARC_FIT_TOLERANCE > 0 && ARC_FIT_MAX_LENGTH > 0, "ARC_FIT_TOLERANCE and ARC_FIT_MAX_LENGTH must be greater than 0.");
+#endif
+
+/**
+ * Pre-parsed G-code Queue
+ */
+#if ENABLED(PREPARSED_GCODE_QUEUE)
+  #if DISABLED(FASTER_GCODE_PARSER)
+    #error "PREPARSED_GCODE_QUEUE requires FASTER_GCODE_PARSER."
+  #elif !WITHIN(PREPARSED_MAX_PARAMS, 1, 26)
+    #error "PREPARSED_MAX_PARAMS must be from 1 to 26."
+  #endif
+#endif
+
 /**
  * RGB_LED Requirements
  */
@@ -81,6 +81,12 @@ namespace Geeetech
     static const char *PARAMETER_STRINGS[] = {FOREACH_PARAMETER(GENERATE_STRING)};
     static const uint8_t PARAMETERS_COUNT = FOREACH_PARAMETER(GENERATE_COUNT);
 
+    enum StatusFrame
+    {
+        FOREACH_STATUS_FRAME(GENERATE_ENUM)
+    };
+    static const uint8_t STATUS_FRAMES_COUNT = FOREACH_STATUS_FRAME(GENERATE_COUNT);
+
     enum EMode {
         FOREACH_E_MODE(GENERATE_ENUM)
     };
@@ -102,11 +108,24 @@ namespace Geeetech
         AskWaitForUser = 15
     };
 
+    // a parameter value inside the received line, not terminated and only valid until the next line is received
+    struct UiParameter
+    {
+        const char *value;
+        uint8_t length;
+
+        char charAt(const uint8_t index) const { return index < length ? value[index] : '\0'; }
+        bool equals(const char *other) const { return length == strlen(other) && 0 == strncmp(value, other, length); }
+        float toFloat() const { return length ? strtof(value, nullptr) : 0.0f; }
+        uintmax_t toUnsigned() const { return length ? strtoumax(value, nullptr, 10) : 0; }
+        void print() const { for (uint8_t i = 0; i < length; i++) SERIAL_CHAR(value[i]); }
+    };
+
     struct UiCommand
     {
         CommandType type;
-        String command;
-        String parameters[PARAMETERS_COUNT];
+        const char *command; // the received line without N-0 and checksum
+        UiParameter parameters[PARAMETERS_COUNT];
     };
 
     class TouchDisplay
@@ -127,9 +146,14 @@ namespace Geeetech
         static millis_t nextStatusSend;
         static bool disableAxisStatusSend;
         static char output[200]; // should be enough for all message
+        static uint32_t sentFrameHash[STATUS_FRAMES_COUNT]; // 0 = unknown to the display
+        static uint32_t sentSettingsHash;
+        static millis_t nextFullStatusRefresh;
         // send methods
         static void setNextSendMs(const millis_t &currentTimeMs);
         static void sendStatusIfNeeded(const millis_t &currentTimeMs);
+        static void forgetSentStatus();
+        static void sendStatusFrame(const StatusFrame frame, const char *message);
         static void send_L1_AxisInfo();
         static void send_L2_TempInfo();
         static void send_L3_PrintInfo();
@@ -140,18 +164,31 @@ namespace Geeetech
         static void send_L18_UserMessage(const UserMessageCode &code);
         static void send_L24_SettingsStatus();
         static void sendToDisplay(PGM_P message, const bool addChecksum = true);
+
+        // transmit queue, drained without blocking from process()
+        static char txQueue[TX_QUEUE_SIZE];
+        static uint16_t txHead, txTail;
+        static bool txInLine;
+        static millis_t nextLineMs;
+        static void queueForDisplay(const char *line, const uint16_t length);
+        static void transmitIfPossible(const millis_t &currentTimeMs);
         static uint32_t getMixerRatio();
         static uint8_t getPrintStatus();
 
+        // receive variables
+        static char rxLine[RX_LINE_SIZE];
+        static uint8_t rxLength;
+        static bool rxOverflow;
         // receive methods
-        static UiCommand receiveCommand();
-        static String receiveCommandString();
-        static UiCommand parseCommandString(const String &commandString);
-        static CommandType parseCommandType(const String &commandString);
-        static void parseCommandParameters(UiCommand &command, const String &commandString);
+        static bool receiveLine();
+        static bool checksumValid();
+        static const char *stripLine();
+        static UiCommand parseCommandString(const char *commandString);
+        static CommandType parseCommandType(const char *commandString);
+        static void parseCommandParameters(UiCommand &command, const char *commandString);
 
         // handle
-        static void handleGcode(const String &command);
+        static void handleGcode(const char *command);
         static void handleUnkownCommand(const UiCommand &command);
         static void handleProprietaryCommand(const UiCommand &command);
 
@@ -184,7 +221,7 @@ namespace Geeetech
         static bool simulatedAutoLevelSwitchOn;
         static void handle_M2120_AutoLeveling(const UiCommand &command);
         static void handle_M2120_P1_ProbeControl(const char &sParameter);
-        static void handle_M2120_P2_StoreZOffset(const String &sParameter);
+        static void handle_M2120_P2_StoreZOffset(const UiParameter &sParameter);
         static void handle_M2120_P3_MoveUp(const char &sParameter);
         static void handle_M2120_P4_MoveDown(const char &sParameter);
         static void handle_M2120_P7_ProbeCenter();
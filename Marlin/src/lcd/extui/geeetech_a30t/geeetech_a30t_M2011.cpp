@@ -42,13 +42,13 @@ namespace Geeetech
 {
     void TouchDisplay::handle_M2011_DoubleZOffset(const UiCommand &command)
     {
-        if (((String) "0").equals(command.parameters[S]))
+        if (command.parameters[S].equals("0"))
         {
             settings.load();
         }
         else
         {
-            float_t offsetValue = strtof(command.parameters[S].c_str(), nullptr);
+            float_t offsetValue = command.parameters[S].toFloat();
             if ('0' == command.parameters[P].charAt(0)) // Z0 offset
             {
                 if (offsetValue > 0)
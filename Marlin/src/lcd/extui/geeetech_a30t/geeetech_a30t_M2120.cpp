@@ -97,9 +97,9 @@ namespace Geeetech
         send_L11_ProbeZOffset_andFakeL1();
     }
 
-    void TouchDisplay::handle_M2120_P2_StoreZOffset(const String &sParameter)
+    void TouchDisplay::handle_M2120_P2_StoreZOffset(const UiParameter &sParameter)
     {
-        setProbeOffset_mm(strtof(sParameter.c_str(), nullptr), ExtUI::Z);
+        setProbeOffset_mm(sParameter.toFloat(), ExtUI::Z);
         settings.save();
     }
 
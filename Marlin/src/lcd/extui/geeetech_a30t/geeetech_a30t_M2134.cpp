@@ -43,7 +43,9 @@ namespace Geeetech
     void TouchDisplay::handle_M2134_RequestFirmware(const UiCommand &command)
     {
 #ifdef GEEETECH_DISPLAY_DEBUG
-        SERIAL_ECHOLNPGM("Firmware info from display: ", command.parameters[FW].c_str());
+        SERIAL_ECHOPGM("Firmware info from display: ");
+        command.parameters[FW].print();
+        SERIAL_EOL();
 #endif
         send_L9_FirmwareInfo();
     }
@@ -42,7 +42,7 @@ namespace Geeetech
 {
     void TouchDisplay::handle_M2135_SetColorMix(const UiCommand &command)
     {
-        uintmax_t value = strtoumax(command.parameters[P].c_str(), NULL, 10);
+        uintmax_t value = command.parameters[P].toUnsigned();
 
         mixer.collector[0] = ((uint8_t)value) & COLOR_MASK;
         mixer.collector[1] = ((uint8_t)(value >> 8)) & COLOR_MASK;
@@ -46,13 +46,13 @@ namespace Geeetech
 
     void TouchDisplay::handle_M290_Babystep(const UiCommand &command)
     {
-        if (((String) "0").equals(command.parameters[Z]))
+        if (command.parameters[Z].equals("0"))
         {
             temporaryBabystepValue = 0.0;
         }
         else
         {
-            const float zOffset = strtof(command.parameters[Z].c_str(), nullptr);
+            const float zOffset = command.parameters[Z].toFloat();
             
             if (zOffset > temporaryBabystepValue)
                 babystep.add_mm(Z_AXIS, 0.01);
@@ -28,8 +28,12 @@
 // settings
 #define GEEETECH_DISPLAY_DEBUG // comment out for production
 #define SEND_CYCLE_IN_MS 1000
+#define FULL_STATUS_REFRESH_IN_MS 10000 // resend status frames even if they did not change
 #define EXTRUDE_CYCLE_IN_MS 1000
 #define SWITCH_EXTRUDER_CYCLE_IN_MS 5000
+#define TX_QUEUE_SIZE 1024     // a full status cycle (L1, L24, L2, L3) is about 800 bytes
+#define TX_LINE_GAP_IN_MS 20   // the display needs this pause between two lines
+#define RX_LINE_SIZE 128       // longest line accepted from the display, including N-0 and checksum
 
 // enum, string array, count, boolean generation
 #define GENERATE_ENUM(ENUM) ENUM,
@@ -64,6 +68,18 @@
     PARAM(Z)                     \
     PARAM(FW)
 
+// status frames that are only resent when their content changed
+#define FOREACH_STATUS_FRAME(FRAME) \
+    FRAME(FRAME_L1)                 \
+    FRAME(FRAME_L2)                 \
+    FRAME(FRAME_L3)                 \
+    FRAME(FRAME_L24_P0)             \
+    FRAME(FRAME_L24_P1)             \
+    FRAME(FRAME_L24_P2)             \
+    FRAME(FRAME_L24_P3)             \
+    FRAME(FRAME_L24_P5)             \
+    FRAME(FRAME_L24_P6)
+
 // modes of extruder moves
 #define FOREACH_E_MODE(MODE) \
     MODE(LOAD)               \
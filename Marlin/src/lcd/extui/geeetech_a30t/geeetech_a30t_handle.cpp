@@ -41,18 +41,24 @@ using namespace ExtUI;
 namespace Geeetech
 {
 
-    void TouchDisplay::handleGcode(const String &gcode)
+    void TouchDisplay::handleGcode(const char *gcode)
     {
 #ifdef GEEETECH_DISPLAY_DEBUG
-        SERIAL_ECHOLNPGM("Queueing command: ", gcode.c_str());
+        SERIAL_ECHOLNPGM("Queueing command: ", gcode);
 #endif
-        queue.enqueue_now_P(PSTR(gcode.c_str()));
+        // never blocks; process() only reads a new line while the display queue has room
+        if (!queue.enqueue_display(gcode))
+        {
+#ifdef GEEETECH_DISPLAY_DEBUG
+            SERIAL_ECHOLNPGM("Display queue full, command dropped: ", gcode);
+#endif
+        }
     }
 
     void TouchDisplay::handleUnkownCommand(const UiCommand &command)
     {
 #ifdef GEEETECH_DISPLAY_DEBUG
-        SERIAL_ECHOLNPGM("Unknown command ignored: ", command.command.c_str());
+        SERIAL_ECHOLNPGM("Unknown command ignored: ", command.command);
 #endif
     }
 
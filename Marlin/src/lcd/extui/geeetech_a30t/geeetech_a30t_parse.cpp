@@ -40,62 +40,55 @@ using namespace ExtUI;
 
 namespace Geeetech
 {
-    UiCommand TouchDisplay::parseCommandString(const String &commandString)
+    UiCommand TouchDisplay::parseCommandString(const char *commandString)
     {
         UiCommand result = {}; // init
         result.type = parseCommandType(commandString);
+        result.command = commandString;
 
-        if (GCode == result.type)
-            result.command = commandString;
-        else if (Unknown != result.type)
+        if (GCode != result.type && Unknown != result.type)
             parseCommandParameters(result, commandString);
 
         return result;
     }
 
-    void TouchDisplay::parseCommandParameters(UiCommand &command, const String &commandString)
+    void TouchDisplay::parseCommandParameters(UiCommand &command, const char *commandString)
     {
-        String currentCommand = COMMAND_STRINGS[command.type];
-        if (commandString.length() + 1 <= currentCommand.length())
-            return; // no parameters detected
-
-        String parameterString = commandString.substring(currentCommand.length() + 1);
+        const char *parameterString = commandString + strlen(COMMAND_STRINGS[command.type]);
         for (uint8_t i = 0; i < PARAMETERS_COUNT; i++)
         {
-            parameterString.trim();
-            if (parameterString.length() == 0)
+            while (' ' == *parameterString)
+                parameterString++;
+            if ('\0' == *parameterString)
                 break;
 
-            if (parameterString.startsWith(PARAMETER_STRINGS[i]))
+            const uint8_t nameLength = strlen(PARAMETER_STRINGS[i]);
+            if (0 == strncmp(parameterString, PARAMETER_STRINGS[i], nameLength))
             {
-                uint8_t substringStart = i == FW ? 3 : strlen(PARAMETER_STRINGS[i]); // need to handle FW differently as it is followed by a colon
-                int index = parameterString.indexOf(' ');
-                if (index > substringStart)
-                {
-                    command.parameters[i] = parameterString.substring(substringStart, index);
-                    parameterString = parameterString.substring(index);
-                }
-                else
-                {
-                    command.parameters[i] = parameterString.substring(substringStart);
-                    break;
-                }
+                const uint8_t valueStart = i == FW ? 3 : nameLength; // need to handle FW differently as it is followed by a colon
+                const char *end = parameterString;
+                while ('\0' != *end && ' ' != *end)
+                    end++;
+                UiParameter &parameter = command.parameters[i];
+                parameter.value = parameterString + MIN(valueStart, end - parameterString);
+                parameter.length = end - parameter.value;
+                parameterString = end;
             }
         }
     }
 
-    CommandType TouchDisplay::parseCommandType(const String &commandString)
+    CommandType TouchDisplay::parseCommandType(const char *commandString)
     {
-        const char firstChar = commandString.charAt(0);
+        const char firstChar = commandString[0];
 
         if ('M' == firstChar || 'L' == firstChar)        // check proprietary commands first
             for (uint8_t i = 2; i < COMMANDS_COUNT; i++) // start at 2 to exclude Unknown and GCode
             {
-                if (commandString.startsWith(COMMAND_STRINGS[i]))
+                if (0 == strncmp(commandString, COMMAND_STRINGS[i], strlen(COMMAND_STRINGS[i])))
                     return (CommandType)i;
             }
 
-        if ('M' == firstChar || ('G' == firstChar && 'e' != commandString.charAt(1))) // filter out Geeetech
+        if ('M' == firstChar || ('G' == firstChar && 'e' != commandString[1])) // filter out Geeetech
             return GCode;
 
         return Unknown;
@@ -64,9 +64,10 @@ namespace Geeetech
     void TouchDisplay::process()
     {
         const millis_t currentTimeMs = millis();
-        if (LCD_SERIAL.available() && !shouldWaitForCommand)
+        // leave further lines in the serial buffer until queued G-code was taken
+        if (!shouldWaitForCommand && !queue.display_queue.full() && receiveLine())
         {
-            UiCommand command = receiveCommand();
+            UiCommand command = parseCommandString(stripLine());
 
             // ignore unkown command types for keeping command group active
             if (Unknown != command.type)
@@ -79,9 +80,13 @@ namespace Geeetech
 
 #ifdef GEEETECH_DISPLAY_DEBUG
             SERIAL_ECHOLNPGM("CommandType: ", COMMAND_STRINGS[command.type]);
-            SERIAL_ECHOLNPGM("String: ", command.command.c_str());
+            SERIAL_ECHOLNPGM("String: ", command.command);
             for (uint8_t j = 0; j < PARAMETERS_COUNT; j++)
-                SERIAL_ECHOLNPGM(PARAMETER_STRINGS[j], command.parameters[j].c_str());
+            {
+                SERIAL_ECHO(PARAMETER_STRINGS[j]);
+                command.parameters[j].print();
+                SERIAL_EOL();
+            }
 #endif
 
             if (GCode == command.type)
@@ -98,6 +103,7 @@ namespace Geeetech
 
         extrudeIfNeeded(currentTimeMs);
         sendStatusIfNeeded(currentTimeMs);
+        transmitIfPossible(currentTimeMs);
     }
 
     void TouchDisplay::showStatus(const char *const message) {
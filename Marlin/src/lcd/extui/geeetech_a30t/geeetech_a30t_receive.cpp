@@ -40,25 +40,70 @@ using namespace ExtUI;
 
 namespace Geeetech
 {
-    UiCommand TouchDisplay::receiveCommand()
+    char TouchDisplay::rxLine[] = {};
+    uint8_t TouchDisplay::rxLength = 0;
+    bool TouchDisplay::rxOverflow = false;
+
+    // collects bytes as they arrive, returns true once a complete line with a valid checksum is in rxLine
+    bool TouchDisplay::receiveLine()
     {
-        return parseCommandString(receiveCommandString());
+        while (LCD_SERIAL.available())
+        {
+            const int c = LCD_SERIAL.read();
+            if (c < 0)
+                break;
+
+            if ('\n' == c)
+            {
+                const bool complete = !rxOverflow && rxLength > 0;
+                rxLine[rxLength] = '\0';
+                rxLength = 0;
+                rxOverflow = false;
+                if (complete && checksumValid())
+                    return true;
+            }
+            else if ('\r' == c)
+                continue;
+            else if (rxLength < RX_LINE_SIZE - 1)
+                rxLine[rxLength++] = c;
+            else
+                rxOverflow = true; // drop the rest of this line
+        }
+        return false;
     }
 
-    String TouchDisplay::receiveCommandString()
+    // the display uses the same checksum as the host protocol: XOR of everything up to the last '*'
+    bool TouchDisplay::checksumValid()
     {
-        String receivedLine = LCD_SERIAL.readStringUntil('\n');
-        int lastStarChar = receivedLine.lastIndexOf('*');
+        char *star = strrchr(rxLine, '*');
+        if (!star)
+            return true; // lines without checksum are accepted as before
 
-        // just remove checksum without checking 8-0
-        String result = receivedLine;
-        if (lastStarChar > 0)
-            result = receivedLine.substring(0, lastStarChar);
+        uint8_t checksum = 0;
+        for (const char *c = rxLine; c < star; c++)
+            checksum ^= *c;
 
-        // have to do "while" here because at least one command uses two times "N-0" :-(
-        while (result.startsWith("N-0 "))
-            result = result.substring(4);
+        char *end;
+        const long expected = strtol(star + 1, &end, 10);
+        if (end == star + 1 || expected != checksum)
+        {
+#ifdef GEEETECH_DISPLAY_DEBUG
+            SERIAL_ECHOLNPGM("Checksum mismatch, line ignored: ", rxLine);
+#endif
+            return false;
+        }
 
+        *star = '\0';
+        return true;
+    }
+
+    // removes the N-0 prefix in place
+    const char *TouchDisplay::stripLine()
+    {
+        const char *result = rxLine;
+        // have to do "while" here because at least one command uses two times "N-0" :-(
+        while (0 == strncmp(result, "N-0 ", 4))
+            result += 4;
         return result;
     }
 
@@ -43,24 +43,74 @@ namespace Geeetech
     millis_t TouchDisplay::nextStatusSend = 0;
     bool TouchDisplay::disableAxisStatusSend = false;
     char TouchDisplay::output[] = {};
+    uint32_t TouchDisplay::sentFrameHash[] = {};
+    uint32_t TouchDisplay::sentSettingsHash = 0;
+    millis_t TouchDisplay::nextFullStatusRefresh = 0;
+    char TouchDisplay::txQueue[] = {};
+    uint16_t TouchDisplay::txHead = 0;
+    uint16_t TouchDisplay::txTail = 0;
+    bool TouchDisplay::txInLine = false;
+    millis_t TouchDisplay::nextLineMs = 0;
+
+    // FNV-1a, never 0 so that 0 can mark a frame as unknown to the display
+    static uint32_t hashBytes(const void *data, const size_t length, uint32_t hash = 2166136261UL)
+    {
+        const uint8_t *bytes = (const uint8_t *)data;
+        for (size_t i = 0; i < length; i++)
+            hash = (hash ^ bytes[i]) * 16777619UL;
+        return hash ? hash : 1;
+    }
+
+    // the display asked for an answer, so send everything again
+    void TouchDisplay::setNextSendMs(const millis_t &currentTimeMs)
+    {
+        nextStatusSend = currentTimeMs;
+        forgetSentStatus();
+    }
 
-    void TouchDisplay::setNextSendMs(const millis_t &currentTimeMs) { nextStatusSend = currentTimeMs; }
+    void TouchDisplay::forgetSentStatus()
+    {
+        ZERO(sentFrameHash);
+        sentSettingsHash = 0;
+    }
 
     void TouchDisplay::sendStatusIfNeeded(const millis_t &currentTimeMs)
     {
         if (ELAPSED(currentTimeMs, nextStatusSend))
         {
+            if (ELAPSED(currentTimeMs, nextFullStatusRefresh))
+            {
+                forgetSentStatus();
+                nextFullStatusRefresh = currentTimeMs + FULL_STATUS_REFRESH_IN_MS;
+            }
+
             if (!disableAxisStatusSend)
             {
                 send_L1_AxisInfo();
                 send_L24_SettingsStatus();
             }
+            else
+            {
+                // the display shows something else meanwhile, so resend once enabled again
+                sentFrameHash[FRAME_L1] = 0;
+                sentSettingsHash = 0;
+            }
             send_L2_TempInfo();
             send_L3_PrintInfo();
             nextStatusSend = currentTimeMs + SEND_CYCLE_IN_MS;
         }
     }
 
+    // only sends the frame if it differs from what the display got last time
+    void TouchDisplay::sendStatusFrame(const StatusFrame frame, const char *message)
+    {
+        const uint32_t hash = hashBytes(message, strlen(message));
+        if (hash == sentFrameHash[frame])
+            return;
+        sentFrameHash[frame] = hash;
+        sendToDisplay(message);
+    }
+
     void TouchDisplay::send_L1_AxisInfo()
     {
         char x[8], y[8], z[8]; // 6 digits + dot + \0
@@ -72,7 +122,7 @@ namespace Geeetech
 
         sprintf(output, "L1 X%s Y%s Z%s F%d",
                 x /*7*/, y /*7*/, z /*7*/, FEEDRATE /*3*/);
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L1, output);
     }
 
     void TouchDisplay::send_L2_TempInfo()
@@ -91,7 +141,7 @@ namespace Geeetech
                 e0CurrentTemp /*5*/, e0TargetTemp /*5*/, E0_ACTIVE /*1*/,
                 SD_ACTIVE /*1*/, F0_SPEED /*3*/, PRINT_SPEED /*3*/, FEEDRATE /*3*/);
 
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L2, output);
     }
 
     void TouchDisplay::send_L3_PrintInfo()
@@ -101,7 +151,7 @@ namespace Geeetech
                 simulatedAutoLevelSwitchOn /*1*/, getMixerRatio() /*7*/, CURRENT_FILENAME /*12*/,
                 getProgress_percent() /*3*/, getProgress_seconds_elapsed() /*6*/);
 
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L3, output);
     }
 
     void TouchDisplay::send_L9_FirmwareInfo()
@@ -126,6 +176,7 @@ namespace Geeetech
         dtostrf(getProbeOffset_mm(ExtUI::Z), 0, 2, probeZOffset);
         sprintf(output, "%s", probeZOffset);
         sendToDisplay(("L1 Z" + (String)output).c_str());
+        sentFrameHash[FRAME_L1] = 0; // the display's axis info was overwritten
         sendToDisplay(("L11 P0 S" + (String)output).c_str());
     }
 
@@ -141,6 +192,16 @@ namespace Geeetech
 
     void TouchDisplay::send_L24_SettingsStatus()
     {
+        // skip formatting altogether while none of the settings changed
+        uint32_t hash = hashBytes(&planner.settings, sizeof(planner.settings));
+        hash = hashBytes(&planner.max_jerk, sizeof(planner.max_jerk), hash);
+        hash = hashBytes(&fwretract.settings.retract_feedrate_mm_s, sizeof(fwretract.settings.retract_feedrate_mm_s), hash);
+        hash = hashBytes(&temporaryBabystepValue, sizeof(temporaryBabystepValue), hash);
+        hash = hashBytes(&endstops.z2_endstop_adj, sizeof(endstops.z2_endstop_adj), hash);
+        if (hash == sentSettingsHash)
+            return;
+        sentSettingsHash = hash;
+
         const String start = "L24 P";
         char varA[10];
         char varB[10];
@@ -154,7 +215,7 @@ namespace Geeetech
         dtostrf(planner.settings.axis_steps_per_mm[Z_AXIS], 0, 2, varC);
         dtostrf(planner.settings.axis_steps_per_mm[E_AXIS], 0, 2, varD);
         sprintf(output, p0.c_str(), varA, varB, varC, varD);
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L24_P0, output);
 
         // velocity (mm/s): A=X-VMax B=Y-VMax C=Z-VMax D=E-VMax E=VMin F=VTravel
         const String p1 = start + "1 A%d B%d C%d D%d E%d F%d";
@@ -165,7 +226,7 @@ namespace Geeetech
                 /*D*/ (int)planner.settings.max_feedrate_mm_s[E_AXIS],
                 /*E*/ MAX((int)planner.settings.min_feedrate_mm_s, 1),
                 /*F*/ MAX((int)planner.settings.min_travel_feedrate_mm_s, 1));
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L24_P1, output);
 
         // acceleration (steps/s2): A=Accel, B=A-Retract, C=X-Max accel, D=Y-Max accel, E=Z-Max accel, F=E-Max accel
         const String p2 = start + "2 A%d B%d C%d D%d E%d F%d";
@@ -176,7 +237,7 @@ namespace Geeetech
                 /*D*/ (int)planner.settings.max_acceleration_mm_per_s2[Y_AXIS],
                 /*E*/ (int)planner.settings.max_acceleration_mm_per_s2[Z_AXIS],
                 /*F*/ (int)planner.settings.max_acceleration_mm_per_s2[E_AXIS]);
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L24_P2, output);
 
         //jerk (mm/s): A=Vx-jerk, B=Vy-jerk, C=Vz-jerk, D=Ve-jerk
         const String p3 = start + "3 A%s B%s C%s D%s";
@@ -185,45 +246,81 @@ namespace Geeetech
         dtostrf(planner.max_jerk.z, 0, 2, varC);
         dtostrf(planner.max_jerk.e, 0, 2, varD);
         sprintf(output, p3.c_str(), varA, varB, varC, varD);
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L24_P3, output);
 
         // babystep (mm): A=Z
         const String p5 = start + "5 A%s";
         dtostrf(temporaryBabystepValue, 0, 2, varA);
         sprintf(output, p5.c_str(), varA);
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L24_P5, output);
 
         // double-z home offset
         const String p6 = start + "6 A%s B%s";
         dtostrf(endstops.z2_endstop_adj > 0 ? endstops.z2_endstop_adj : 0.0, 0, 2, varA);
         dtostrf(endstops.z2_endstop_adj < 0 ? -endstops.z2_endstop_adj : 0.0, 0, 2, varB);
         sprintf(output, p6.c_str(), varA, varB);
-        sendToDisplay(output);
+        sendStatusFrame(FRAME_L24_P6, output);
     }
 
     void TouchDisplay::sendToDisplay(PGM_P message, const bool addChecksum)
     {
+        // longer messages are cut, so that every line keeps its checksum and line end
+        const int messageLength = MIN(strlen(message), sizeof(output) - 1);
+        char line[sizeof(output) + 12]; // "N-0 " + message + "*255" + "\r\n"
+        int length;
         if (addChecksum)
         {
-            LCD_SERIAL.write("N-0 ");
-
-            uint8_t checksum = 115; // checksum of line sent above
-            for (unsigned int i = 0; i < strlen(message); i++)
-            {
+            uint8_t checksum = 115; // checksum of "N-0 "
+            for (int i = 0; i < messageLength; i++)
                 checksum ^= message[i];
-                LCD_SERIAL.write(message[i]);
-            }
-            char number[5];
-            sprintf(number, "*%d", checksum);
-            LCD_SERIAL.write(number);
+            length = sprintf(line, "N-0 %.*s*%d\r\n", messageLength, message, checksum);
         }
         else
+            length = sprintf(line, "%.*s\r\n", messageLength, message);
+
+        queueForDisplay(line, length);
+        transmitIfPossible(millis());
+    }
+
+    void TouchDisplay::queueForDisplay(const char *line, const uint16_t length)
+    {
+        const uint16_t used = (txHead + TX_QUEUE_SIZE - txTail) % TX_QUEUE_SIZE;
+        if (used + length >= TX_QUEUE_SIZE)
         {
-            LCD_SERIAL.write(message);
+            // only whole lines are queued, the next status cycle will resend
+#ifdef GEEETECH_DISPLAY_DEBUG
+            SERIAL_ECHOLNPGM("Display TX queue full, dropped: ", line);
+#endif
+            return;
         }
+        for (uint16_t i = 0; i < length; i++)
+        {
+            txQueue[txHead] = line[i];
+            txHead = (txHead + 1) % TX_QUEUE_SIZE;
+        }
+    }
 
-        LCD_SERIAL.write("\r\n");
-        delay(20);
+    void TouchDisplay::transmitIfPossible(const millis_t &currentTimeMs)
+    {
+        if (txHead == txTail)
+            return;
+        // keep the gap the display needs before starting the next line
+        if (!txInLine && PENDING(currentTimeMs, nextLineMs))
+            return;
+
+        // only hand over what fits into the UART buffer, so this never blocks
+        for (int room = LCD_SERIAL.availableForWrite(); room > 0 && txHead != txTail; room--)
+        {
+            const char c = txQueue[txTail];
+            txTail = (txTail + 1) % TX_QUEUE_SIZE;
+            LCD_SERIAL.write(c);
+            txInLine = ('\n' != c);
+            if (!txInLine)
+            {
+                nextLineMs = currentTimeMs + TX_LINE_GAP_IN_MS;
+                break;
+            }
+        }
     }
 
 } // namespace Geeetech
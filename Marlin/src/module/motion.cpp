@@ -71,6 +71,12 @@
   #include "../feature/babystep.h"
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  #include "../feature/segment_merge.h"
+#elif ENABLED(ARC_FITTING)
+  #include "../feature/arc_fit.h"
+#endif
+
 #define DEBUG_OUT ENABLED(DEBUG_LEVELING_FEATURE)
 #include "../core/debug_out.h"
 
@@ -314,6 +320,8 @@ void home_if_needed(const bool keeplev/*=false*/) {
  * position from the last-updated stepper positions.
  */
 void quickstop_stepper() {
+  TERN_(SEGMENT_MERGE, segment_merge.discard());
+  TERN_(ARC_FITTING, arc_fit.discard());
   planner.quick_stop();
   planner.synchronize();
   set_current_from_steppers_for_axis(ALL_AXES_ENUM);
@@ -119,6 +119,7 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
+block_plan_t Planner::block_plan[BLOCK_BUFFER_SIZE];
 volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
                  Planner::block_buffer_nonbusy, // Index of the first non-busy block
                  Planner::block_buffer_planned, // Index of the optimally planned block
@@ -126,6 +127,11 @@ volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
+#if ENABLED(PLANNER_BENCHMARK)
+  bool Planner::full_replan; // = false
+  uint32_t Planner::trapezoids_calculated; // = 0
+#endif
+
 planner_settings_t Planner::settings;           // Initialized by settings.load()
 
 #if ENABLED(LASER_POWER_INLINE)
@@ -742,7 +748,7 @@ block_t* Planner::get_current_block() {
     if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
 
     // We can't be sure how long an active block will take, so don't count it.
-    TERN_(HAS_WIRED_LCD, block_buffer_runtime_us -= block->segment_time_us);
+    TERN_(HAS_WIRED_LCD, block_buffer_runtime_us -= plan_of(block).segment_time_us);
 
     // As this block is busy, advance the nonbusy block pointer
     block_buffer_nonbusy = next_block_index(block_buffer_tail);
@@ -780,11 +786,24 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
   NOLESS(initial_rate, uint32_t(MINIMAL_STEP_RATE));
   NOLESS(final_rate, uint32_t(MINIMAL_STEP_RATE));
 
+  // Classic jerk may let a slow block join a faster one at the faster one's safe speed,
+  // but no block may run faster than its own nominal rate. (It may be below MINIMAL_STEP_RATE.)
+  NOMORE(initial_rate, block->nominal_rate);
+  NOMORE(final_rate, block->nominal_rate);
+
+  // The trapezoid only depends on the rates, so there's nothing to do if they are
+  // unchanged, e.g. when the reverse pass raised an entry speed that the forward
+  // pass lowered again. New blocks start with an initial_rate of 0.
+  if (initial_rate == block->initial_rate && final_rate == block->final_rate && !TERN0(PLANNER_BENCHMARK, full_replan))
+    return;
+
+  TERN_(PLANNER_BENCHMARK, trapezoids_calculated++);
+
   #if ENABLED(S_CURVE_ACCELERATION)
     uint32_t cruise_rate = initial_rate;
   #endif
 
-  const int32_t accel = block->acceleration_steps_per_s2;
+  const int32_t accel = plan_of(block).acceleration_steps_per_s2;
 
           // Steps required for acceleration, deceleration to/from nominal rate
   uint32_t accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
@@ -792,33 +811,77 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
           // Steps between acceleration and deceleration, if any
   int32_t plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
 
-  // Does accelerate_steps + decelerate_steps exceed step_event_count?
-  // Then we can't possibly reach the nominal rate, there will be no cruising.
-  // Use intersection_distance() to calculate accel / braking time in order to
-  // reach the final_rate exactly at the end of this block.
-  if (plateau_steps < 0) {
-    const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
-    accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), block->step_event_count);
-    plateau_steps = 0;
+  #if HAS_S_CURVE_JERK_LIMIT
+
+    // The jerk limit in steps/s³ along this block
+    const float jerk = float(S_CURVE_JERK_LIMIT) * accel / plan_of(block).acceleration;
+
+    // Jerk-limited ramps take at least as long as the trapezoid's, so the trapezoid's cruise rate is
+    // an upper bound. If both ramps don't fit at that rate, bisect the highest rate where they do.
+    float cruise = block->nominal_rate;
+    if (plateau_steps < 0)
+      NOMORE(cruise, final_speed(initial_rate, accel, _MAX(intersection_distance(initial_rate, final_rate, accel, block->step_event_count), 0)));
+    NOLESS(cruise, float(_MAX(initial_rate, final_rate)));
+
+    float accelerate_distance = ramp_distance(initial_rate, cruise, accel, jerk),
+          decelerate_distance = ramp_distance(cruise, final_rate, accel, jerk);
+    if (accelerate_distance + decelerate_distance > block->step_event_count) {
+      float low = _MAX(initial_rate, final_rate), high = cruise;
+      LOOP_L_N(i, 10) {
+        cruise = (low + high) * 0.5f;
+        if (ramp_distance(initial_rate, cruise, accel, jerk) + ramp_distance(cruise, final_rate, accel, jerk) > block->step_event_count)
+          high = cruise;
+        else
+          low = cruise;
+      }
+      cruise = low;
+      accelerate_distance = ramp_distance(initial_rate, cruise, accel, jerk);
+      decelerate_distance = ramp_distance(cruise, final_rate, accel, jerk);
+    }
+
+    // Rather start decelerating early than late, so the final rate is reached in time
+    decelerate_steps = _MIN(uint32_t(CEIL(decelerate_distance)), block->step_event_count);
+    accelerate_steps = _MIN(uint32_t(CEIL(accelerate_distance)), block->step_event_count - decelerate_steps);
+    plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
+    cruise_rate = cruise;
+
+    // The Bézier curves are evaluated over the ramp durations
+    const uint32_t acceleration_time = ramp_time(cruise - initial_rate, accel, jerk) * (STEPPER_TIMER_RATE),
+                   deceleration_time = ramp_time(cruise - final_rate, accel, jerk) * (STEPPER_TIMER_RATE),
+                   acceleration_time_inverse = get_period_inverse(acceleration_time),
+                   deceleration_time_inverse = get_period_inverse(deceleration_time);
 
+  #else
+
+    // Does accelerate_steps + decelerate_steps exceed step_event_count?
+    // Then we can't possibly reach the nominal rate, there will be no cruising.
+    // Use intersection_distance() to calculate accel / braking time in order to
+    // reach the final_rate exactly at the end of this block.
+    if (plateau_steps < 0) {
+      const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
+      accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), block->step_event_count);
+      plateau_steps = 0;
+
+      #if ENABLED(S_CURVE_ACCELERATION)
+        // We won't reach the cruising rate. Let's calculate the speed we will reach
+        cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
+      #endif
+    }
     #if ENABLED(S_CURVE_ACCELERATION)
-      // We won't reach the cruising rate. Let's calculate the speed we will reach
-      cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
+      else // We have some plateau time, so the cruise rate will be the nominal rate
+        cruise_rate = block->nominal_rate;
     #endif
-  }
-  #if ENABLED(S_CURVE_ACCELERATION)
-    else // We have some plateau time, so the cruise rate will be the nominal rate
-      cruise_rate = block->nominal_rate;
-  #endif
 
-  #if ENABLED(S_CURVE_ACCELERATION)
-    // Jerk controlled speed requires to express speed versus time, NOT steps
-    uint32_t acceleration_time = ((float)(cruise_rate - initial_rate) / accel) * (STEPPER_TIMER_RATE),
-             deceleration_time = ((float)(cruise_rate - final_rate) / accel) * (STEPPER_TIMER_RATE),
-    // And to offload calculations from the ISR, we also calculate the inverse of those times here
-             acceleration_time_inverse = get_period_inverse(acceleration_time),
-             deceleration_time_inverse = get_period_inverse(deceleration_time);
-  #endif
+    #if ENABLED(S_CURVE_ACCELERATION)
+      // Jerk controlled speed requires to express speed versus time, NOT steps
+      uint32_t acceleration_time = ((float)(cruise_rate - initial_rate) / accel) * (STEPPER_TIMER_RATE),
+               deceleration_time = ((float)(cruise_rate - final_rate) / accel) * (STEPPER_TIMER_RATE),
+      // And to offload calculations from the ISR, we also calculate the inverse of those times here
+               acceleration_time_inverse = get_period_inverse(acceleration_time),
+               deceleration_time_inverse = get_period_inverse(deceleration_time);
+    #endif
+
+  #endif // !HAS_S_CURVE_JERK_LIMIT
 
   // Store new block parameters
   block->accelerate_until = accelerate_steps;
@@ -944,11 +1007,11 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
     // in the next block, there is no need to recheck. Block is cruising and there is no need to
     // compute anything for this block,
     // If not, block entry speed needs to be recalculated to ensure maximum possible planned speed.
-    const float max_entry_speed_sqr = current->max_entry_speed_sqr;
+    const float max_entry_speed_sqr = plan_of(current).max_entry_speed_sqr;
 
     // Compute maximum entry speed decelerating over the current block from its exit speed.
     // If not at the maximum entry speed, or the previous block entry speed changed
-    if (current->entry_speed_sqr != max_entry_speed_sqr || (next && TEST(next->flag, BLOCK_BIT_RECALCULATE))) {
+    if (plan_of(current).entry_speed_sqr != max_entry_speed_sqr || (next && TEST(next->flag, BLOCK_BIT_RECALCULATE))) {
 
       // If nominal length true, max junction speed is guaranteed to be reached.
       // If a block can de/ac-celerate from nominal speed to zero within the length of the block, then
@@ -960,8 +1023,8 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
 
       const float new_entry_speed_sqr = TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH)
         ? max_entry_speed_sqr
-        : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-current->acceleration, next ? next->entry_speed_sqr : sq(float(MINIMUM_PLANNER_SPEED)), current->millimeters));
-      if (current->entry_speed_sqr != new_entry_speed_sqr) {
+        : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-plan_of(current).acceleration, next ? plan_of(next).entry_speed_sqr : sq(float(MINIMUM_PLANNER_SPEED)), plan_of(current).millimeters));
+      if (plan_of(current).entry_speed_sqr != new_entry_speed_sqr) {
 
         // Need to recalculate the block speed - Mark it now, so the stepper
         // ISR does not consume the block before being recalculated
@@ -978,7 +1041,7 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
         else {
           // Block is not BUSY so this is ahead of the Stepper ISR:
           // Just Set the new entry speed.
-          current->entry_speed_sqr = new_entry_speed_sqr;
+          plan_of(current).entry_speed_sqr = new_entry_speed_sqr;
         }
       }
     }
@@ -1042,13 +1105,13 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
     // maximized, and reverse-planned. If nominal length is set, max junction speed is
     // guaranteed to be reached. No need to recheck.
     if (!TEST(previous->flag, BLOCK_BIT_NOMINAL_LENGTH) &&
-      previous->entry_speed_sqr < current->entry_speed_sqr) {
+      plan_of(previous).entry_speed_sqr < plan_of(current).entry_speed_sqr) {
 
       // Compute the maximum allowable speed
-      const float new_entry_speed_sqr = max_allowable_speed_sqr(-previous->acceleration, previous->entry_speed_sqr, previous->millimeters);
+      const float new_entry_speed_sqr = max_allowable_speed_sqr(-plan_of(previous).acceleration, plan_of(previous).entry_speed_sqr, plan_of(previous).millimeters);
 
       // If true, current block is full-acceleration and we can move the planned pointer forward.
-      if (new_entry_speed_sqr < current->entry_speed_sqr) {
+      if (new_entry_speed_sqr < plan_of(current).entry_speed_sqr) {
 
         // Mark we need to recompute the trapezoidal shape, and do it now,
         // so the stepper ISR does not consume the block before being recalculated
@@ -1067,7 +1130,7 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
           // Block is not BUSY, we won the race against the Stepper ISR:
 
           // Always <= max_entry_speed_sqr. Backward pass sets this.
-          current->entry_speed_sqr = new_entry_speed_sqr; // Always <= max_entry_speed_sqr. Backward pass sets this.
+          plan_of(current).entry_speed_sqr = new_entry_speed_sqr; // Always <= max_entry_speed_sqr. Backward pass sets this.
 
           // Set optimal plan pointer.
           block_buffer_planned = block_index;
@@ -1079,7 +1142,7 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
     // point in the buffer. When the plan is bracketed by either the beginning of the
     // buffer and a maximum entry speed or two maximum entry speeds, every block in between
     // cannot logically be further improved. Hence, we don't have to recompute them anymore.
-    if (current->entry_speed_sqr == current->max_entry_speed_sqr)
+    if (plan_of(current).entry_speed_sqr == plan_of(current).max_entry_speed_sqr)
       block_buffer_planned = block_index;
   }
 }
@@ -1126,10 +1189,12 @@ void Planner::forward_pass() {
  * Recalculate the trapezoid speed profiles for all blocks in the plan
  * according to the entry_factor for each junction. Must be called by
  * recalculate() after updating the blocks.
+ *
+ * Blocks before first_block_index were already optimally planned, so
+ * neither their entry nor their exit speed can have changed.
  */
-void Planner::recalculate_trapezoids() {
-  // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
+void Planner::recalculate_trapezoids(const uint8_t first_block_index) {
+  uint8_t block_index = first_block_index,
           head_block_index = block_buffer_head;
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
@@ -1158,7 +1223,7 @@ void Planner::recalculate_trapezoids() {
 
     // Skip sync and page blocks
     if (!(next->flag & BLOCK_MASK_SYNC) && !IS_PAGE(next)) {
-      next_entry_speed = SQRT(next->entry_speed_sqr);
+      next_entry_speed = SQRT(plan_of(next).entry_speed_sqr);
 
       if (block) {
         // Recalculate if current block entry or exit junction speed has changed.
@@ -1176,16 +1241,9 @@ void Planner::recalculate_trapezoids() {
             // Block is not BUSY, we won the race against the Stepper ISR:
 
             // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-            const float current_nominal_speed = SQRT(block->nominal_speed_sqr),
+            const float current_nominal_speed = SQRT(plan_of(block).nominal_speed_sqr),
                         nomr = 1.0f / current_nominal_speed;
             calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
-            #if ENABLED(LIN_ADVANCE)
-              if (block->use_advance_lead) {
-                const float comp = block->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
-                block->max_adv_steps = current_nominal_speed * comp;
-                block->final_adv_steps = next_entry_speed * comp;
-              }
-            #endif
           }
 
           // Reset current only to ensure next trapezoid is computed - The
@@ -1215,16 +1273,9 @@ void Planner::recalculate_trapezoids() {
     if (!stepper.is_block_busy(block)) {
       // Block is not BUSY, we won the race against the Stepper ISR:
 
-      const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
+      const float next_nominal_speed = SQRT(plan_of(next).nominal_speed_sqr),
                   nomr = 1.0f / next_nominal_speed;
       calculate_trapezoid_for_block(next, next_entry_speed * nomr, float(MINIMUM_PLANNER_SPEED) * nomr);
-      #if ENABLED(LIN_ADVANCE)
-        if (next->use_advance_lead) {
-          const float comp = next->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
-          next->max_adv_steps = next_nominal_speed * comp;
-          next->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
-        }
-      #endif
     }
 
     // Reset next only to ensure its trapezoid is computed - The stepper is free to use
@@ -1234,6 +1285,11 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+  // The passes below may move the planned pointer forward, but the blocks
+  // they pass over still need their trapezoids, so start from here.
+  // The ISR may push the planned pointer, so get a stable local copy.
+  const uint8_t first_block_index = TERN0(PLANNER_BENCHMARK, full_replan) ? block_buffer_tail : block_buffer_planned;
+
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
   // If there is just one block, no planning can be done. Avoid it!
@@ -1241,7 +1297,7 @@ void Planner::recalculate() {
     reverse_pass();
     forward_pass();
   }
-  recalculate_trapezoids();
+  recalculate_trapezoids(first_block_index);
 }
 
 #if HAS_FAN && DISABLED(LASER_SYNCHRONOUS_M106_M107)
@@ -1459,7 +1515,7 @@ void Planner::check_axes_activity() {
     for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
       block_t *block = &block_buffer[b];
       if (LINEAR_AXIS_GANG(block->steps.x, || block->steps.y, || block->steps.z, || block->steps.i, || block->steps.j, || block->steps.k)) {
-        const float se = (float)block->steps.e / block->step_event_count * SQRT(block->nominal_speed_sqr); // mm/sec;
+        const float se = (float)block->steps.e / block->step_event_count * SQRT(plan_of(block).nominal_speed_sqr); // mm/sec;
         NOLESS(high, se);
       }
     }
@@ -1852,6 +1908,8 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , feedRate_t fr_mm_s, const uint8_t extruder, const_float_t millimeters/*=0.0*/
 ) {
+  block_plan_t &plan = plan_of(block);
+
   int32_t LOGICAL_AXIS_LIST(
     de = target.e - position.e,
     da = target.a - position.a,
@@ -1978,6 +2036,9 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   // Clear all flags, including the "busy" bit
   block->flag = 0x00;
 
+  // No trapezoid has been calculated yet
+  block->initial_rate = 0;
+
   // Set direction bits
   block->direction_bits = dm;
 
@@ -2082,13 +2143,13 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       && block->steps.k < MIN_STEPS_PER_SEGMENT
     )
   ) {
-    block->millimeters = TERN0(HAS_EXTRUDERS, ABS(steps_dist_mm.e));
+    plan.millimeters = TERN0(HAS_EXTRUDERS, ABS(steps_dist_mm.e));
   }
   else {
     if (millimeters)
-      block->millimeters = millimeters;
+      plan.millimeters = millimeters;
     else {
-      block->millimeters = SQRT(
+      plan.millimeters = SQRT(
         #if ANY(CORE_IS_XY, MARKFORGED_XY, MARKFORGED_YX)
           LINEAR_AXIS_GANG(
               sq(steps_dist_mm.head.x), + sq(steps_dist_mm.head.y), + sq(steps_dist_mm.z),
@@ -2251,7 +2312,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   else
     NOLESS(fr_mm_s, settings.min_travel_feedrate_mm_s);
 
-  const float inverse_millimeters = 1.0f / block->millimeters;  // Inverse millimeters to remove multiple divides
+  const float inverse_millimeters = 1.0f / plan.millimeters;  // Inverse millimeters to remove multiple divides
 
   // Calculate inverse time for this move. No divide by zero due to previous checks.
   // Example: At 120mm/s a 60mm move takes 0.5s. So this will give 2.0.
@@ -2288,12 +2349,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     const bool was_enabled = stepper.suspend();
 
     block_buffer_runtime_us += segment_time_us;
-    block->segment_time_us = segment_time_us;
+    plan.segment_time_us = segment_time_us;
 
     if (was_enabled) stepper.wake_up();
   #endif
 
-  block->nominal_speed_sqr = sq(block->millimeters * inverse_secs);   // (mm/sec)^2 Always > 0
+  plan.nominal_speed_sqr = sq(plan.millimeters * inverse_secs);   // (mm/sec)^2 Always > 0
   block->nominal_rate = CEIL(block->step_event_count * inverse_secs); // (step/sec) Always > 0
 
   #if ENABLED(FILAMENT_WIDTH_SENSOR)
@@ -2389,18 +2450,18 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   if (speed_factor < 1.0f) {
     current_speed *= speed_factor;
     block->nominal_rate *= speed_factor;
-    block->nominal_speed_sqr = block->nominal_speed_sqr * sq(speed_factor);
+    plan.nominal_speed_sqr = plan.nominal_speed_sqr * sq(speed_factor);
   }
 
   // Compute and limit the acceleration rate for the trapezoid generator.
   const float steps_per_mm = block->step_event_count * inverse_millimeters;
   uint32_t accel;
+  TERN_(LIN_ADVANCE, bool use_advance_lead = false);
   if (LINEAR_AXIS_GANG(
          !block->steps.a, && !block->steps.b, && !block->steps.c,
       && !block->steps.i, && !block->steps.j, && !block->steps.k)
   ) {                                                             // Is this a retract / recover move?
     accel = CEIL(settings.retract_acceleration * steps_per_mm);   // Convert to: acceleration steps/sec^2
-    TERN_(LIN_ADVANCE, block->use_advance_lead = false);          // No linear advance for simple retract/recover
   }
   else {
     #define LIMIT_ACCEL_LONG(AXIS,INDX) do{ \
@@ -2433,14 +2494,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
        *
        * de > 0             : Extruder is running forward (e.g., for "Wipe while retracting" (Slic3r) or "Combing" (Cura) moves)
        */
-      block->use_advance_lead =  esteps
-                              && extruder_advance_K[active_extruder]
-                              && de > 0;
+      use_advance_lead =  esteps
+                       && extruder_advance_K[active_extruder]
+                       && de > 0;
 
-      if (block->use_advance_lead) {
-        block->e_D_ratio = (target_float.e - position_float.e) /
+      if (use_advance_lead) {
+        const float e_D_ratio = (target_float.e - position_float.e) /
           #if IS_KINEMATIC
-            block->millimeters
+            plan.millimeters
           #else
             SQRT(sq(target_float.x - position_float.x)
                + sq(target_float.y - position_float.y)
@@ -2450,10 +2511,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
         // Check for unusual high e_D ratio to detect if a retract move was combined with the last print move due to min. steps per segment. Never execute this with advance!
         // This assumes no one will use a retract length of 0mm < retr_length < ~0.2mm and no one will print 100mm wide lines using 3mm filament or 35mm wide lines using 1.75mm filament.
-        if (block->e_D_ratio > 3.0f)
-          block->use_advance_lead = false;
+        if (e_D_ratio > 3.0f)
+          use_advance_lead = false;
         else {
-          const uint32_t max_accel_steps_per_s2 = MAX_E_JERK(extruder) / (extruder_advance_K[active_extruder] * block->e_D_ratio) * steps_per_mm;
+          const uint32_t max_accel_steps_per_s2 = MAX_E_JERK(extruder) / (extruder_advance_K[active_extruder] * e_D_ratio) * steps_per_mm;
           if (TERN0(LA_DEBUG, accel > max_accel_steps_per_s2))
             SERIAL_ECHOLNPGM("Acceleration limited.");
           NOMORE(accel, max_accel_steps_per_s2);
@@ -2485,21 +2546,26 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       );
     }
   }
-  block->acceleration_steps_per_s2 = accel;
-  block->acceleration = accel / steps_per_mm;
+  plan.acceleration_steps_per_s2 = accel;
+  plan.acceleration = accel / steps_per_mm;
   #if DISABLED(S_CURVE_ACCELERATION)
     block->acceleration_rate = (uint32_t)(accel * (sq(4096.0f) / (STEPPER_TIMER_RATE)));
   #endif
   #if ENABLED(LIN_ADVANCE)
-    if (block->use_advance_lead) {
-      block->advance_speed = (STEPPER_TIMER_RATE) / (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
-      #if ENABLED(LA_DEBUG)
-        if (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * 2 < SQRT(block->nominal_speed_sqr) * block->e_D_ratio)
-          SERIAL_ECHOLNPGM("More than 2 steps per eISR loop executed.");
-        if (block->advance_speed < 200)
-          SERIAL_ECHOLNPGM("eISR running at > 10kHz.");
-      #endif
-    }
+    /**
+     * The advance is K times the E speed, which is in proportion to the step rate
+     * of the block. The Stepper follows it from the rate on the velocity profile,
+     * S-curve or not. Blocks without advance bring the advance back to zero.
+     */
+    block->la_scale = use_advance_lead
+      ? extruder_advance_K[active_extruder] * block->steps.e / block->step_event_count * float(1UL << 24)
+      : 0;
+    // Changes in the advance that outrun the velocity profile are paced at the E jerk speed
+    block->advance_speed = (STEPPER_TIMER_RATE) / (MAX_E_JERK(extruder) * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
+    #if ENABLED(LA_DEBUG)
+      if (block->advance_speed < 200)
+        SERIAL_ECHOLNPGM("eISR running at > 10kHz.");
+    #endif
   #endif
 
   float vmax_junction_sqr; // Initial limit on the segment entry velocity (mm/s)^2
@@ -2587,7 +2653,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         xyze_float_t junction_unit_vec = unit_vec - prev_unit_vec;
         normalize_junction_vector(junction_unit_vec);
 
-        const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
+        const float junction_acceleration = limit_value_by_axis_maximum(plan.acceleration, junction_unit_vec),
                     sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
 
         vmax_junction_sqr = junction_acceleration * junction_deviation_mm * sin_theta_d2 / (1.0f - sin_theta_d2);
@@ -2595,7 +2661,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         #if ENABLED(JD_HANDLE_SMALL_SEGMENTS)
 
           // For small moves with >135° junction (octagon) find speed for approximate arc
-          if (block->millimeters < 1 && junction_cos_theta < -0.7071067812f) {
+          if (plan.millimeters < 1 && junction_cos_theta < -0.7071067812f) {
 
             #if ENABLED(JD_USE_MATH_ACOS)
 
@@ -2674,7 +2740,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
             #endif
 
-            const float limit_sqr = (block->millimeters * junction_acceleration) / junction_theta;
+            const float limit_sqr = (plan.millimeters * junction_acceleration) / junction_theta;
             NOMORE(vmax_junction_sqr, limit_sqr);
           }
 
@@ -2682,7 +2748,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       }
 
       // Get the lowest speed
-      vmax_junction_sqr = _MIN(vmax_junction_sqr, block->nominal_speed_sqr, previous_nominal_speed_sqr);
+      vmax_junction_sqr = _MIN(vmax_junction_sqr, plan.nominal_speed_sqr, previous_nominal_speed_sqr);
     }
     else // Init entry speed to zero. Assume it starts from rest. Planner will correct this later.
       vmax_junction_sqr = 0;
@@ -2705,7 +2771,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
      * Adapted from Průša MKS firmware
      * https://github.com/prusa3d/Prusa-Firmware
      */
-    CACHED_SQRT(nominal_speed, block->nominal_speed_sqr);
+    CACHED_SQRT(nominal_speed, plan.nominal_speed_sqr);
 
     // Exit speed limited by a jerk to full halt of a previous last segment
     static float previous_safe_speed;
@@ -2801,14 +2867,14 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   #endif // Classic Jerk Limiting
 
   // Max entry speed of this block equals the max exit speed of the previous block.
-  block->max_entry_speed_sqr = vmax_junction_sqr;
+  plan.max_entry_speed_sqr = vmax_junction_sqr;
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
-  const float v_allowable_sqr = max_allowable_speed_sqr(-block->acceleration, sq(float(MINIMUM_PLANNER_SPEED)), block->millimeters);
+  const float v_allowable_sqr = max_allowable_speed_sqr(-plan.acceleration, sq(float(MINIMUM_PLANNER_SPEED)), plan.millimeters);
 
   // If we are trying to add a split block, start with the
   // max. allowed speed to avoid an interrupted first move.
-  block->entry_speed_sqr = !split_move ? sq(float(MINIMUM_PLANNER_SPEED)) : _MIN(vmax_junction_sqr, v_allowable_sqr);
+  plan.entry_speed_sqr = !split_move ? sq(float(MINIMUM_PLANNER_SPEED)) : _MIN(vmax_junction_sqr, v_allowable_sqr);
 
   // Initialize planner efficiency flags
   // Set flag if block will always reach maximum junction speed regardless of entry/exit speeds.
@@ -2818,11 +2884,11 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   // block nominal speed limits both the current and next maximum junction speeds. Hence, in both
   // the reverse and forward planners, the corresponding block junction speed will always be at the
   // the maximum junction speed and may always be ignored for any speed reduction checks.
-  block->flag |= block->nominal_speed_sqr <= v_allowable_sqr ? BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_NOMINAL_LENGTH : BLOCK_FLAG_RECALCULATE;
+  block->flag |= plan.nominal_speed_sqr <= v_allowable_sqr ? BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_NOMINAL_LENGTH : BLOCK_FLAG_RECALCULATE;
 
   // Update previous path unit_vector and nominal speed
   previous_speed = current_speed;
-  previous_nominal_speed_sqr = block->nominal_speed_sqr;
+  previous_nominal_speed_sqr = plan.nominal_speed_sqr;
 
   position = target;  // Update the position
 
@@ -2850,6 +2916,7 @@ void Planner::buffer_sync_block(TERN_(LASER_SYNCHRONOUS_M106_M107, uint8_t sync_
 
   // Clear block
   memset(block, 0, sizeof(block_t));
+  memset(&plan_of(block), 0, sizeof(block_plan_t));
 
   block->flag = sync_flag;
 
@@ -3069,6 +3136,12 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s, cons
     block->accelerate_until = 0;
     block->decelerate_after = block->step_event_count;
 
+    #if ENABLED(LIN_ADVANCE)
+      // Pages have their E steps worked out by the host
+      block->la_scale = 0;
+      block->advance_speed = (STEPPER_TIMER_RATE) / (MAX_E_JERK(extruder) * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
+    #endif
+
     // Will be set to last direction later if directional format.
     block->direction_bits = 0;
 
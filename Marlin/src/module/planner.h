@@ -79,6 +79,10 @@
   #include "../feature/closedloop.h"
 #endif
 
+#if HAS_SHAPING
+  #include "shaping.h"
+#endif
+
 // Feedrate for manual moves
 #ifdef MANUAL_FEEDRATE
   constexpr xyze_feedrate_t _mf = MANUAL_FEEDRATE,
@@ -164,17 +168,15 @@ enum BlockFlag : char {
  *
  * The "nominal" values are as-specified by gcode, and
  * may never actually be reached due to acceleration limits.
+ *
+ * This is what the Stepper ISR reads. What only the look-ahead
+ * needs is kept apart in a block_plan_t (See below).
  */
 typedef struct block_t {
 
   volatile uint8_t flag;                    // Block flags (See BlockFlag enum above) - Modified by ISR and main thread!
 
-  // Fields used by the motion planner to manage acceleration
-  float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
-        entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
-        max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
-        millimeters,                        // The total travel of this block in mm
-        acceleration;                       // acceleration mm/sec^2
+  axis_bits_t direction_bits;               // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
 
   union {
     abce_ulong_t steps;                     // Step count along each axis
@@ -206,21 +208,15 @@ typedef struct block_t {
     uint32_t acceleration_rate;             // The acceleration rate used for acceleration calculation
   #endif
 
-  axis_bits_t direction_bits;               // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
-
   // Advance extrusion
   #if ENABLED(LIN_ADVANCE)
-    bool use_advance_lead;
-    uint16_t advance_speed,                 // STEP timer value for extruder speed offset ISR
-             max_adv_steps,                 // max. advance steps to get cruising speed pressure (not always nominal_speed!)
-             final_adv_steps;               // advance steps due to exit speed
-    float e_D_ratio;
+    uint32_t la_scale,                      // Advance steps per step/s of the block's step rate, x2^24 (0 = No advance)
+             advance_speed;                 // STEP timer ticks per advance step at E jerk speed, the fastest advance
   #endif
 
   uint32_t nominal_rate,                    // The nominal step rate for this block in step_events/sec
            initial_rate,                    // The jerk-adjusted step rate at start of block
-           final_rate,                      // The minimal rate at exit
-           acceleration_steps_per_s2;       // acceleration steps/sec^2
+           final_rate;                      // The minimal rate at exit
 
   #if ENABLED(DIRECT_STEPPING)
     page_idx_t page_idx;                    // Page index used for direct stepping
@@ -238,10 +234,6 @@ typedef struct block_t {
     uint8_t valve_pressure, e_to_p_pressure;
   #endif
 
-  #if HAS_WIRED_LCD
-    uint32_t segment_time_us;
-  #endif
-
   #if ENABLED(POWER_LOSS_RECOVERY)
     uint32_t sdpos;
   #endif
@@ -252,6 +244,27 @@ typedef struct block_t {
 
 } block_t;
 
+/**
+ * struct block_plan_t
+ *
+ * The look-ahead's side of a planner buffer entry, in Planner::block_plan[]
+ * alongside the block_t it belongs to. Only the Planner uses these values,
+ * so the Stepper ISR never has to touch them.
+ */
+typedef struct {
+  float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
+        entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
+        max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
+        millimeters,                        // The total travel of this block in mm
+        acceleration;                       // acceleration mm/sec^2
+
+  uint32_t acceleration_steps_per_s2;       // acceleration steps/sec^2
+
+  #if HAS_WIRED_LCD
+    uint32_t segment_time_us;
+  #endif
+} block_plan_t;
+
 #if ANY(LIN_ADVANCE, SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL)
   #define HAS_POSITION_FLOAT 1
 #endif
@@ -337,6 +350,7 @@ class Planner {
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
+    static block_plan_t block_plan[BLOCK_BUFFER_SIZE]; // Look-ahead data for each block_buffer entry
     static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
                             block_buffer_nonbusy,   // Index of the first non busy block
                             block_buffer_planned,   // Index of the optimally planned block
@@ -715,6 +729,9 @@ class Planner {
       return &block_buffer[block_buffer_head];
     }
 
+    // The look-ahead data for a block in the buffer
+    FORCE_INLINE static block_plan_t& plan_of(const block_t * const block) { return block_plan[block - block_buffer]; }
+
     /**
      * Planner::_buffer_steps
      *
@@ -869,10 +886,12 @@ class Planner {
     // Triggered position of an axis in mm (not core-savvy)
     static float triggered_position_mm(const AxisEnum axis);
 
-    // Blocks are queued, or we're running out moves, or the closed loop controller is waiting
+    // Blocks are queued, or we're running out moves, or the closed loop controller is waiting,
+    // or input shaping is still finishing the last move
     static inline bool busy() {
       return (has_blocks_queued() || cleaning_buffer_counter
           || TERN0(EXTERNAL_CLOSED_LOOP_CONTROLLER, CLOSED_LOOP_WAITING())
+          || TERN0(HAS_SHAPING, input_shaping.busy())
       );
     }
 
@@ -910,6 +929,11 @@ class Planner {
         block_buffer_tail = next_block_index(block_buffer_tail);
     }
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      static bool full_replan;                  // Replan the whole buffer like before incremental recalculation
+      static uint32_t trapezoids_calculated;    // Trapezoids that were actually (re)computed
+    #endif
+
     #if HAS_WIRED_LCD
       static uint16_t block_buffer_runtime();
       static void clear_block_buffer_runtime();
@@ -970,13 +994,45 @@ class Planner {
       return (accel * 2 * distance - sq(initial_rate) + sq(final_rate)) / (accel * 4);
     }
 
+    #if HAS_S_CURVE_JERK_LIMIT
+      // The peak jerk of a Bézier speed ramp by dv in T seconds is S_CURVE_JERK_FACTOR * dv / T^2
+      #define S_CURVE_JERK_FACTOR 5.7735027f // 10 / sqrt(3)
+
+      /**
+       * Duration of a Bézier speed ramp by 'dv' with an average of 'accel',
+       * lengthened where needed to stay within 'jerk'
+       */
+      static float ramp_time(const_float_t dv, const_float_t accel, const_float_t jerk) {
+        return _MAX(dv / accel, SQRT(S_CURVE_JERK_FACTOR * dv / jerk));
+      }
+
+      /**
+       * Distance covered by a Bézier speed ramp from 'v0' to 'v1'
+       */
+      static float ramp_distance(const_float_t v0, const_float_t v1, const_float_t accel, const_float_t jerk) {
+        return (v0 + v1) * 0.5f * ramp_time(ABS(v1 - v0), accel, jerk);
+      }
+    #endif
+
     /**
      * Calculate the maximum allowable speed squared at this point, in order
      * to reach 'target_velocity_sqr' using 'acceleration' within a given
      * 'distance'.
      */
     static float max_allowable_speed_sqr(const_float_t accel, const_float_t target_velocity_sqr, const_float_t distance) {
-      return target_velocity_sqr - 2 * accel * distance;
+      #if HAS_S_CURVE_JERK_LIMIT
+        // A jerk-limited ramp by dv = s^2 from v covers (v + dv / 2) * sqrt(S_CURVE_JERK_FACTOR * dv / jerk),
+        // so s^3 + 2 v s = 2 * distance * sqrt(jerk / S_CURVE_JERK_FACTOR). Newton's method from an upper
+        // bound converges from above, with the linear and the cubic term alone each giving such a bound.
+        const float v = SQRT(target_velocity_sqr), p = 2 * v,
+                    q = 2 * distance * SQRT(float(S_CURVE_JERK_LIMIT) / S_CURVE_JERK_FACTOR);
+        float s = cbrtf(q);
+        if (p > 0) NOMORE(s, q / p);
+        LOOP_L_N(i, 3) s -= (s * (s * s + p) - q) / (3 * s * s + p);
+        return _MIN(target_velocity_sqr - 2 * accel * distance, sq(v + sq(s)));
+      #else
+        return target_velocity_sqr - 2 * accel * distance;
+      #endif
     }
 
     #if ENABLED(S_CURVE_ACCELERATION)
@@ -996,7 +1052,7 @@ class Planner {
     static void reverse_pass();
     static void forward_pass();
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const uint8_t first_block_index);
 
     static void recalculate();
 
@@ -402,6 +402,16 @@ typedef struct SettingsDataStruct {
   //
   float planner_extruder_advance_K[_MAX(EXTRUDERS, 1)]; // M900 K  planner.extruder_advance_K
 
+  //
+  // INPUT_SHAPING
+  //
+  #if ENABLED(INPUT_SHAPING_X)
+    shaping_params_t shaping_x;                         // M593 X T F D
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    shaping_params_t shaping_y;                         // M593 Y T F D
+  #endif
+
   //
   // HAS_MOTOR_CURRENT_PWM
   //
@@ -1290,6 +1300,18 @@ void MarlinSettings::postprocess() {
       #endif
     }
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING_X)
+      _FIELD_TEST(shaping_x);
+      EEPROM_WRITE(input_shaping.x.params);
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+      _FIELD_TEST(shaping_y);
+      EEPROM_WRITE(input_shaping.y.params);
+    #endif
+
     //
     // Motor Current PWM
     //
@@ -2182,6 +2204,26 @@ void MarlinSettings::postprocess() {
         #endif
       }
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING_X)
+      {
+        shaping_params_t shaping_x;
+        _FIELD_TEST(shaping_x);
+        EEPROM_READ(shaping_x);
+        if (!validating) stepper.set_shaping_params(X_AXIS, shaping_x);
+      }
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+      {
+        shaping_params_t shaping_y;
+        _FIELD_TEST(shaping_y);
+        EEPROM_READ(shaping_y);
+        if (!validating) stepper.set_shaping_params(Y_AXIS, shaping_y);
+      }
+      #endif
+
       //
       // Motor Current PWM
       //
@@ -3006,6 +3048,17 @@ void MarlinSettings::reset() {
     }
   #endif
 
+  //
+  // Input Shaping
+  //
+
+  #if ENABLED(INPUT_SHAPING_X)
+    stepper.set_shaping_params(X_AXIS, { ShaperType(SHAPING_TYPE_X), SHAPING_FREQ_X, SHAPING_ZETA_X });
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    stepper.set_shaping_params(Y_AXIS, { ShaperType(SHAPING_TYPE_Y), SHAPING_FREQ_Y, SHAPING_ZETA_Y });
+  #endif
+
   //
   // Motor Current PWM
   //
@@ -3308,6 +3361,11 @@ void MarlinSettings::reset() {
     //
     TERN_(LIN_ADVANCE, gcode.M900_report(forReplay));
 
+    //
+    // Input Shaping
+    //
+    TERN_(HAS_SHAPING, gcode.M593_report(forReplay));
+
     //
     // Motor Current (SPI or PWM)
     //
@@ -0,0 +1,115 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * shaping.cpp - Input shaping of the X and Y step streams
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if HAS_SHAPING
+
+#include "shaping.h"
+
+InputShaping input_shaping;
+
+uint32_t InputShaping::now; // = 0
+
+#if ENABLED(INPUT_SHAPING_X)
+  AxisShaper InputShaping::x;
+#endif
+#if ENABLED(INPUT_SHAPING_Y)
+  AxisShaper InputShaping::y;
+#endif
+
+/**
+ * Compute the impulses of the shaper. Amplitudes and delays are the usual
+ * ones for a resonance at 'frequency' with damping ratio 'zeta':
+ *
+ *   ZV  : 1, K                      at 0, T/2
+ *   ZVD : 1, 2K, K²                 at 0, T/2, T
+ *   MZV : 1-√½, (√2-1)K', (1-√½)K'² at 0, 3T/8, 3T/4
+ *
+ * where T is the damped period, K = exp(-ζπ/√(1-ζ²)) and K' = exp(-¾ζπ/√(1-ζ²)).
+ */
+void AxisShaper::set(const shaping_params_t &p) {
+  params = p;
+
+  float a[SHAPER_MAX_IMPULSES] = { 1 }, t[SHAPER_MAX_IMPULSES] = { 0 };
+  uint8_t count = 1;
+  if (p.frequency > 0) {
+    const float df = SQRT(1.0f - sq(p.zeta)),
+                period = 1.0f / (p.frequency * df);
+    switch (p.type) {
+      default:
+      case SHAPER_ZV: {
+        const float k = expf(-p.zeta * float(M_PI) / df);
+        a[1] = k; t[1] = period * 0.5f;
+        count = 2;
+      } break;
+      case SHAPER_ZVD: {
+        const float k = expf(-p.zeta * float(M_PI) / df);
+        a[1] = 2 * k; t[1] = period * 0.5f;
+        a[2] = sq(k); t[2] = period;
+        count = 3;
+      } break;
+      case SHAPER_MZV: {
+        const float k = expf(-0.75f * p.zeta * float(M_PI) / df);
+        a[0] = 1.0f - 0.70710678f;                    // 1 - √½
+        a[1] = 0.41421356f * k; t[1] = period * 0.375f; // √2 - 1
+        a[2] = a[0] * sq(k);    t[2] = period * 0.75f;
+        count = 3;
+      } break;
+    }
+  }
+
+  // Normalize to a whole step, giving the rounding error to the first impulse
+  float sum = 0;
+  LOOP_L_N(i, count) sum += a[i];
+  int32_t first = SHAPING_UNIT;
+  for (uint8_t i = count; --i;) {
+    amplitude[i] = LROUND(a[i] / sum * SHAPING_UNIT);
+    delay[i] = LROUND(t[i] * (STEPPER_TIMER_RATE));
+    first -= amplitude[i];
+  }
+  amplitude[0] = first;
+  delay[0] = 0;
+  echoes = count - 1;
+
+  error = 0;
+  head = 0;
+  LOOP_L_N(i, SHAPER_MAX_IMPULSES) tail[i] = 0;
+}
+
+int32_t AxisShaper::discard() {
+  // Each commanded step adds up to a whole step, so this is a whole number of steps
+  int32_t pending = error;
+  for (uint8_t i = 1; i <= echoes; ++i) {
+    for (uint16_t j = tail[i]; j != head; j = next_index(j))
+      pending += TEST(queue[j], 0) ? amplitude[i] : -amplitude[i];
+    tail[i] = head;
+  }
+  error = 0;
+  return pending / SHAPING_UNIT;
+}
+
+#endif // HAS_SHAPING
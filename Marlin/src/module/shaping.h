@@ -0,0 +1,158 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * shaping.h - Input shaping of the X and Y step streams
+ *
+ * Every commanded step of a shaped axis is split into two or three partial
+ * steps (impulses) spread over about half a period of the axis' resonance,
+ * so that the ringing excited by the first is cancelled by the others.
+ * The impulses are summed per axis in fixed point and a real step is taken
+ * whenever the sum reaches half a step, so the axis ends up exactly where
+ * the commanded steps put it.
+ *
+ * The first impulse is taken by the pulse phase together with the commanded
+ * step. The delayed ones are timed from a queue of commanded steps that has
+ * one read index per delay.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+enum ShaperType : uint8_t { SHAPER_ZV, SHAPER_ZVD, SHAPER_MZV };
+
+typedef struct {
+  ShaperType type;
+  float frequency,    // (Hz) 0 to disable shaping
+        zeta;         // Damping ratio
+} shaping_params_t;
+
+#define SHAPER_MAX_IMPULSES 3
+
+// A whole step in the fixed-point sum of impulses
+#define SHAPING_UNIT 0x4000L
+
+// The queue has to cover the longest delay (a full period, for ZVD) at the highest step rate
+#ifdef SHAPING_MAX_STEPRATE
+  constexpr float shaping_max_steprate = SHAPING_MAX_STEPRATE;
+#else
+  constexpr float _shaping_spu[] = DEFAULT_AXIS_STEPS_PER_UNIT, _shaping_mfr[] = DEFAULT_MAX_FEEDRATE;
+  constexpr float shaping_max_steprate = _MAX(
+    TERN0(INPUT_SHAPING_X, _shaping_spu[X_AXIS] * _shaping_mfr[X_AXIS]),
+    TERN0(INPUT_SHAPING_Y, _shaping_spu[Y_AXIS] * _shaping_mfr[Y_AXIS])
+  );
+#endif
+constexpr uint16_t shaping_queue_size = shaping_max_steprate / (SHAPING_MIN_FREQ) + 3;
+
+class AxisShaper {
+  public:
+    shaping_params_t params;                  // As set by M593
+    uint8_t echoes;                           // Count of delayed impulses, 0 when disabled
+    int16_t amplitude[SHAPER_MAX_IMPULSES];   // Share of the step taken by each impulse, in SHAPING_UNIT
+    uint32_t delay[SHAPER_MAX_IMPULSES];      // (ticks) Delay of each impulse after the commanded step
+    int32_t error;                            // Impulses not yet taken as steps, in SHAPING_UNIT
+    bool forward;                             // Direction of the last step taken
+
+    // Apply new parameters. Only while the axis is at rest.
+    void set(const shaping_params_t &p);
+
+    // Forget the impulses not taken yet, returning how many steps they add up to
+    int32_t discard();
+
+    FORCE_INLINE bool enabled() const { return echoes; }
+
+    // Impulses are still queued, or a step is still to be taken
+    FORCE_INLINE bool busy() const { return echoes && (tail[echoes] != head || !WITHIN(error, -(SHAPING_UNIT / 2), SHAPING_UNIT / 2 - 1)); }
+
+    // Take the first impulse of a commanded step and queue the step for the others
+    FORCE_INLINE void command(const bool fwd, const uint32_t now) {
+      const uint16_t next = next_index(head);
+      if (next == tail[echoes]) {             // No room, so take the whole step at once
+        error += fwd ? SHAPING_UNIT : -SHAPING_UNIT;
+        return;
+      }
+      error += fwd ? amplitude[0] : -amplitude[0];
+      queue[head] = (now << 1) | fwd;
+      head = next;
+    }
+
+    // Take the next impulse of each delay, if it's due
+    FORCE_INLINE void echo(const uint32_t now) {
+      for (uint8_t i = 1; i <= echoes; ++i) {
+        if (tail[i] == head) continue;
+        const uint32_t entry = queue[tail[i]];
+        if (age(entry, now) < delay[i]) continue;
+        error += TEST(entry, 0) ? amplitude[i] : -amplitude[i];
+        tail[i] = next_index(tail[i]);
+      }
+    }
+
+    // Take a step once half of it is due. 1 = forward, -1 = backward, 0 = none.
+    FORCE_INLINE int8_t step() {
+      if (error >= SHAPING_UNIT / 2)   { error -= SHAPING_UNIT; return 1; }
+      if (error < -(SHAPING_UNIT / 2)) { error += SHAPING_UNIT; return -1; }
+      return 0;
+    }
+
+    // Ticks until the next impulse is due, 0 if a step is due now
+    FORCE_INLINE uint32_t next_due(const uint32_t now) const {
+      if (!WITHIN(error, -(SHAPING_UNIT / 2), SHAPING_UNIT / 2 - 1)) return 0;
+      uint32_t wait = UINT32_MAX;
+      for (uint8_t i = 1; i <= echoes; ++i) {
+        if (tail[i] == head) continue;
+        const uint32_t t = age(queue[tail[i]], now);
+        NOMORE(wait, t < delay[i] ? delay[i] - t : 0);
+      }
+      return wait;
+    }
+
+  private:
+    uint32_t queue[shaping_queue_size];       // Commanded steps as (ticks << 1) | forward
+    uint16_t head, tail[SHAPER_MAX_IMPULSES]; // Write index and one read index per delay
+
+    static FORCE_INLINE uint16_t next_index(const uint16_t i) { return i + 1 < shaping_queue_size ? i + 1 : 0; }
+
+    // Ticks since the step was queued. Times are kept in 31 bits to make room for the direction.
+    static FORCE_INLINE uint32_t age(const uint32_t entry, const uint32_t now) { return uint32_t((now << 1) - (entry & ~1UL)) >> 1; }
+};
+
+class InputShaping {
+  public:
+    static uint32_t now;                      // (ticks) Stepper time, advanced by the Stepper ISR
+
+    #if ENABLED(INPUT_SHAPING_X)
+      static AxisShaper x;
+    #endif
+    #if ENABLED(INPUT_SHAPING_Y)
+      static AxisShaper y;
+    #endif
+
+    // Some shaped axis hasn't finished moving yet
+    static inline bool busy() { return TERN0(INPUT_SHAPING_X, x.busy()) || TERN0(INPUT_SHAPING_Y, y.busy()); }
+
+    // Ticks until the next impulse is due on any axis
+    static inline uint32_t next_due() {
+      return _MIN(TERN(INPUT_SHAPING_X, x.next_due(now), UINT32_MAX), TERN(INPUT_SHAPING_Y, y.next_due(now), UINT32_MAX));
+    }
+};
+
+extern InputShaping input_shaping;
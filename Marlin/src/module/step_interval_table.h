@@ -0,0 +1,78 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * step_interval_table.h - Step rate to timer interval without a divide
+ *
+ * The 32-bit counterpart of speed_lookuptable.h, built by the compiler for
+ * the configured STEPPER_TIMER_RATE. The step rate is normalized so its
+ * top bit is set, the next 8 bits select a table entry and the 8 below them
+ * interpolate linearly to the next one. The table holds the interval for
+ * each mantissa, scaled up by 2^STEP_INTERVAL_SHIFT for precision, and the
+ * exponent of the rate becomes the final shift.
+ *
+ * The result is STEPPER_TIMER_RATE / step_rate, rounded, within 10ppm (under
+ * a tick for any interval shorter than 50000 ticks). It costs two table reads,
+ * one multiply and a few shifts, so it pays off on MCUs without a hardware
+ * divider. Cortex-M3/M4 (UDIV) are usually as fast with the plain divide.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#define STEP_INTERVAL_TABLE_BITS 8
+#define STEP_INTERVAL_TABLE_SIZE (1 + _BV(STEP_INTERVAL_TABLE_BITS))
+
+// Largest scale that leaves every entry room for rounding in 32 bits
+constexpr uint8_t step_interval_shift(const uint8_t s=0) {
+  return (uint64_t(STEPPER_TIMER_RATE) << (s + 1)) >> (STEP_INTERVAL_TABLE_BITS) <= INT32_MAX ? step_interval_shift(s + 1) : s;
+}
+#define STEP_INTERVAL_SHIFT step_interval_shift()
+
+static_assert(STEP_INTERVAL_SHIFT >= STEP_INTERVAL_TABLE_BITS, "STEPPER_TIMER_RATE is too high for STEP_INTERVAL_TABLE.");
+
+struct step_interval_table_t {
+  uint32_t entry[STEP_INTERVAL_TABLE_SIZE];
+
+  // Interval (scaled) of each mantissa from 1.0 to 2.0, in 1/256 increments
+  constexpr step_interval_table_t() : entry() {
+    for (uint16_t i = 0; i < STEP_INTERVAL_TABLE_SIZE; ++i) {
+      const uint64_t m = _BV(STEP_INTERVAL_TABLE_BITS) + i;
+      entry[i] = uint32_t(((uint64_t(STEPPER_TIMER_RATE) << STEP_INTERVAL_SHIFT) + m / 2) / m);
+    }
+  }
+};
+
+static constexpr step_interval_table_t step_interval_table;
+
+// STEPPER_TIMER_RATE / step_rate, for 0 < step_rate < STEPPER_TIMER_RATE
+FORCE_INLINE static uint32_t step_interval(const uint32_t step_rate) {
+  const uint8_t lz = __builtin_clz(step_rate);
+  const uint32_t norm = step_rate << lz;  // Top bit set: the mantissa is norm / 2^23, from 256 to 511
+  const uint16_t idx = (norm >> (31 - (STEP_INTERVAL_TABLE_BITS))) & (_BV(STEP_INTERVAL_TABLE_BITS) - 1);
+  const uint8_t frac = norm >> (31 - 2 * (STEP_INTERVAL_TABLE_BITS));
+  const uint32_t hi = step_interval_table.entry[idx], lo = step_interval_table.entry[idx + 1],
+                 scaled = hi - (((hi - lo) * frac) >> 8);
+  // step_rate is the mantissa times 2^(23 - lz)
+  const uint8_t shift = STEP_INTERVAL_SHIFT + (31 - (STEP_INTERVAL_TABLE_BITS)) - lz;
+  return (scaled + ((1UL << shift) >> 1)) >> shift;
+}
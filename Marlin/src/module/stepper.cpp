@@ -195,6 +195,19 @@ uint8_t Stepper::steps_per_isr;
 
 IF_DISABLED(ADAPTIVE_STEP_SMOOTHING, constexpr) uint8_t Stepper::oversampling_factor;
 
+#if ENABLED(ADAPTIVE_MULTI_STEPPING)
+  #ifndef HAL_CYCLE_COUNT
+    #error "ADAPTIVE_MULTI_STEPPING requires a cycle counter (HAL_CYCLE_COUNT), e.g., a Cortex-M3 or better."
+  #elif ENABLED(DISABLE_MULTI_STEPPING)
+    #error "ADAPTIVE_MULTI_STEPPING is incompatible with DISABLE_MULTI_STEPPING."
+  #endif
+  // Start from the estimates behind the fixed limits. The limits are set for each new block.
+  uint32_t Stepper::isr_base_cycles = (ISR_BASE_CYCLES + ISR_S_CURVE_CYCLES + ISR_LA_BASE_CYCLES + ISR_LA_LOOP_CYCLES) << 4,
+           Stepper::isr_pulse_cycles = (ISR_LOOP_CYCLES) << 4,
+           Stepper::isr_pulse_events = 1 << 4,
+           Stepper::isr_rate_limit[8];
+#endif
+
 xyze_long_t Stepper::delta_error{0};
 
 xyze_ulong_t Stepper::advance_dividend{0};
@@ -227,13 +240,10 @@ uint32_t Stepper::advance_divisor = 0,
   uint32_t Stepper::nextAdvanceISR = LA_ADV_NEVER,
            Stepper::LA_isr_rate = LA_ADV_NEVER;
   uint16_t Stepper::LA_current_adv_steps = 0,
-           Stepper::LA_final_adv_steps,
-           Stepper::LA_max_adv_steps;
+           Stepper::LA_target_adv_steps = 0;
 
   int8_t   Stepper::LA_steps = 0;
 
-  bool Stepper::LA_use_advance_lead;
-
 #endif // LIN_ADVANCE
 
 #if ENABLED(INTEGRATED_BABYSTEPPING)
@@ -587,8 +597,24 @@ void Stepper::set_directions() {
       count_direction[_AXIS(A)] = 1;            \
     }
 
-  TERN_(HAS_X_DIR, SET_STEP_DIR(X)); // A
-  TERN_(HAS_Y_DIR, SET_STEP_DIR(Y)); // B
+  #if HAS_SHAPING
+    // A shaped axis may still be finishing the previous move, so it keeps its own DIR
+    #define SET_SHAPED_DIR(A, S) do{ \
+      count_direction[_AXIS(A)] = motor_direction(_AXIS(A)) ? -1 : 1; \
+      A##_APPLY_DIR(input_shaping.S.forward != INVERT_##A##_DIR, false); \
+    }while(0)
+  #endif
+
+  #if ENABLED(INPUT_SHAPING_X)
+    if (input_shaping.x.enabled()) SET_SHAPED_DIR(X, x); else SET_STEP_DIR(X); // A
+  #else
+    TERN_(HAS_X_DIR, SET_STEP_DIR(X)); // A
+  #endif
+  #if ENABLED(INPUT_SHAPING_Y)
+    if (input_shaping.y.enabled()) SET_SHAPED_DIR(Y, y); else SET_STEP_DIR(Y); // B
+  #else
+    TERN_(HAS_Y_DIR, SET_STEP_DIR(Y)); // B
+  #endif
   TERN_(HAS_Z_DIR, SET_STEP_DIR(Z)); // C
   TERN_(HAS_I_DIR, SET_STEP_DIR(I));
   TERN_(HAS_J_DIR, SET_STEP_DIR(J));
@@ -1467,6 +1493,31 @@ HAL_STEP_TIMER_ISR() {
   #define STEP_MULTIPLY(A,B) MultiU24X32toH16(A, B)
 #endif
 
+#if ENABLED(ADAPTIVE_MULTI_STEPPING)
+
+  /**
+   * Get the highest ISR rate for each multistepping rate that keeps the
+   * Stepper ISR within STEPPER_ISR_BUDGET, using the measured cost of an
+   * ISR call plus that of each step event in it. Called for each new block.
+   */
+  void Stepper::update_isr_rate_limits() {
+    constexpr uint32_t budget = (F_CPU) / 100 * (STEPPER_ISR_BUDGET), // Cycles per second for the ISR
+                       margin = (F_CPU) / 1000000UL;                  // The 1µs isr() keeps between calls
+    const uint32_t step_cycles = (isr_pulse_cycles << 4) / _MAX(isr_pulse_events, 1U), // x16
+                   isr_cycles = isr_base_cycles + (margin << 4);                        // x16
+    LOOP_L_N(i, COUNT(isr_rate_limit)) {
+      // Doubling the steps per ISR only pays while they share more than a step's cost.
+      // Beyond that it would just bunch up the steps, so stay at this rate whatever the load.
+      if (i < COUNT(isr_rate_limit) - 1 && (isr_cycles >> i) < step_cycles) {
+        isr_rate_limit[i] = UINT32_MAX;
+        break;
+      }
+      isr_rate_limit[i] = budget / ((isr_cycles + (step_cycles << i)) >> 4);
+    }
+  }
+
+#endif
+
 void Stepper::isr() {
 
   static uint32_t nextMainISR = 0;  // Interval until the next main Stepper Pulse phase (0 = Now)
@@ -1488,13 +1539,31 @@ void Stepper::isr() {
   // Limit the amount of iterations
   uint8_t max_loops = 10;
 
+  #if ENABLED(ADAPTIVE_MULTI_STEPPING)
+    const uint32_t isr_start = HAL_CYCLE_COUNT();
+    uint32_t pulse_cycles = 0, pulse_events = 0;
+  #endif
+
   // We need this variable here to be able to use it in the following loop
   hal_timer_t min_ticks;
   do {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
-    if (!nextMainISR) pulse_phase_isr();                            // 0 = Do coordinated axes Stepper pulses
+    #if ENABLED(ADAPTIVE_MULTI_STEPPING)
+      if (!nextMainISR) {                                           // 0 = Do coordinated axes Stepper pulses
+        const uint32_t pulse_start = HAL_CYCLE_COUNT(), events_start = step_events_completed;
+        pulse_phase_isr();
+        pulse_cycles += HAL_CYCLE_COUNT() - pulse_start;
+        pulse_events += step_events_completed - events_start;
+      }
+    #else
+      if (!nextMainISR) pulse_phase_isr();                          // 0 = Do coordinated axes Stepper pulses
+    #endif
+
+    #if HAS_SHAPING
+      if (!input_shaping.next_due()) shaping_isr();                 // 0 = Do delayed input shaping pulses
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
       if (!nextAdvanceISR) nextAdvanceISR = advance_isr();          // 0 = Do Linear Advance E Stepper pulses
@@ -1517,12 +1586,17 @@ void Stepper::isr() {
         NOLESS(nextBabystepISR, nextMainISR / 2);       // TODO: Only look at axes enabled for baby-stepping
     #endif
 
+    #if HAS_SHAPING
+      const uint32_t nextShapingISR = input_shaping.next_due();
+    #endif
+
     // Get the interval to the next ISR call
     const uint32_t interval = _MIN(
       uint32_t(HAL_TIMER_TYPE_MAX),                     // Come back in a very long time
       nextMainISR                                       // Time until the next Pulse / Block phase
       OPTARG(LIN_ADVANCE, nextAdvanceISR)               // Come back early for Linear Advance?
       OPTARG(INTEGRATED_BABYSTEPPING, nextBabystepISR)  // Come back early for Babystepping?
+      OPTARG(HAS_SHAPING, nextShapingISR)               // Come back early for Input Shaping?
     );
 
     //
@@ -1542,6 +1616,8 @@ void Stepper::isr() {
       if (nextBabystepISR != BABYSTEP_NEVER) nextBabystepISR -= interval;
     #endif
 
+    TERN_(HAS_SHAPING, input_shaping.now += interval);
+
     /**
      * This needs to avoid a race-condition caused by interleaving
      * of interrupts required by both the LA and Stepper algorithms.
@@ -1610,6 +1686,11 @@ void Stepper::isr() {
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(MF_TIMER_STEP, hal_timer_t(next_isr_ticks));
 
+  #if ENABLED(ADAPTIVE_MULTI_STEPPING)
+    // Only ISRs that stepped tell how the cost grows with the steps per ISR
+    if (pulse_events) measure_isr(HAL_CYCLE_COUNT() - isr_start, pulse_cycles, pulse_events);
+  #endif
+
   // Don't forget to finally reenable interrupts
   ENABLE_ISRS();
 }
@@ -1634,6 +1715,9 @@ void Stepper::pulse_phase_isr() {
   if (abort_current_block) {
     abort_current_block = false;
     if (current_block) discard_current_block();
+    // Also stop the shaped axes, counting the steps they didn't take
+    TERN_(INPUT_SHAPING_X, count_position.x -= input_shaping.x.discard());
+    TERN_(INPUT_SHAPING_Y, count_position.y -= input_shaping.y.discard());
   }
 
   // If there is no current block, do nothing
@@ -1684,6 +1768,29 @@ void Stepper::pulse_phase_isr() {
       } \
     }while(0)
 
+    #if HAS_SHAPING
+      // Take a step once the shaper's impulses add up to one, reversing first if needed
+      #define SHAPED_STEP(AXIS, S) do{ \
+        const int8_t dir = input_shaping.S.step(); \
+        step_needed[_AXIS(AXIS)] = dir; \
+        if (dir && (dir > 0) != input_shaping.S.forward) { \
+          input_shaping.S.forward = dir > 0; \
+          DIR_WAIT_BEFORE(); \
+          AXIS##_APPLY_DIR(input_shaping.S.forward != INVERT_##AXIS##_DIR, false); \
+          DIR_WAIT_AFTER(); \
+        } \
+      }while(0)
+
+      // Pass the commanded step to the shaper, which decides on the actual step
+      #define PULSE_PREP_SHAPING(AXIS, S) do{ \
+        if (input_shaping.S.enabled()) { \
+          if (step_needed[_AXIS(AXIS)]) input_shaping.S.command(count_direction[_AXIS(AXIS)] > 0, input_shaping.now); \
+          input_shaping.S.echo(input_shaping.now); \
+          SHAPED_STEP(AXIS, S); \
+        } \
+      }while(0)
+    #endif
+
     // Direct Stepping page?
     const bool is_page = IS_PAGE(current_block);
 
@@ -1789,6 +1896,11 @@ void Stepper::pulse_phase_isr() {
         #else
           #error "Unknown direct stepping page format!"
         #endif
+
+        // With Linear Advance the eISR does all E steps (and counts them)
+        #if ENABLED(LIN_ADVANCE)
+          if (step_needed.e) motor_direction(E_AXIS) ? --LA_steps : ++LA_steps;
+        #endif
       }
 
     #endif // DIRECT_STEPPING
@@ -1831,6 +1943,10 @@ void Stepper::pulse_phase_isr() {
       #endif
     }
 
+    // Shaped axes step when their impulses add up, not when commanded
+    TERN_(INPUT_SHAPING_X, PULSE_PREP_SHAPING(X, x));
+    TERN_(INPUT_SHAPING_Y, PULSE_PREP_SHAPING(Y, y));
+
     #if ISR_MULTI_STEPS
       if (firstStep)
         firstStep = false;
@@ -1860,7 +1976,7 @@ void Stepper::pulse_phase_isr() {
 
     #if DISABLED(LIN_ADVANCE)
       #if ENABLED(MIXING_EXTRUDER)
-        if (step_needed.e) E_STEP_WRITE(mixer.get_next_stepper(), !INVERT_E_STEP_PIN);
+        if (step_needed.e) MIXER_STEP_WRITE(mixer.get_next_steppers(count_direction.e > 0), !INVERT_E_STEP_PIN);
       #elif HAS_E0_STEP
         PULSE_START(E);
       #endif
@@ -1900,7 +2016,7 @@ void Stepper::pulse_phase_isr() {
       #if ENABLED(MIXING_EXTRUDER)
         if (delta_error.e >= 0) {
           delta_error.e -= advance_divisor;
-          E_STEP_WRITE(mixer.get_stepper(), INVERT_E_STEP_PIN);
+          MIXER_STEP_WRITE(mixer.get_steppers(), INVERT_E_STEP_PIN);
         }
       #elif HAS_E0_STEP
         PULSE_STOP(E);
@@ -1914,6 +2030,59 @@ void Stepper::pulse_phase_isr() {
   } while (--events_to_do);
 }
 
+#if HAS_SHAPING
+
+  /**
+   * Take the input shaping impulses that are due and do their steps.
+   * The pulse phase takes one impulse per delay with every event, this
+   * catches up with the rest and keeps the axes moving between blocks.
+   */
+  void Stepper::shaping_isr() {
+    xyze_bool_t step_needed{0};
+
+    #if ISR_MULTI_STEPS
+      bool firstStep = true;
+      USING_TIMED_PULSE();
+    #endif
+
+    do {
+      #if ENABLED(INPUT_SHAPING_X)
+        input_shaping.x.echo(input_shaping.now);
+        SHAPED_STEP(X, x);
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+        input_shaping.y.echo(input_shaping.now);
+        SHAPED_STEP(Y, y);
+      #endif
+
+      if (step_needed.x || step_needed.y) {
+        #if ISR_MULTI_STEPS
+          if (firstStep)
+            firstStep = false;
+          else
+            AWAIT_LOW_PULSE();
+        #endif
+
+        TERN_(INPUT_SHAPING_X, PULSE_START(X));
+        TERN_(INPUT_SHAPING_Y, PULSE_START(Y));
+
+        #if ISR_MULTI_STEPS
+          START_HIGH_PULSE();
+          AWAIT_HIGH_PULSE();
+        #endif
+
+        TERN_(INPUT_SHAPING_X, PULSE_STOP(X));
+        TERN_(INPUT_SHAPING_Y, PULSE_STOP(Y));
+
+        #if ISR_MULTI_STEPS
+          START_LOW_PULSE();
+        #endif
+      }
+    } while (!input_shaping.next_due());
+  }
+
+#endif // HAS_SHAPING
+
 // This is the last half of the stepper interrupt: This one processes and
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
@@ -1942,7 +2111,9 @@ uint32_t Stepper::block_phase_isr() {
           PAGE_SEGMENT_UPDATE_POS(X);
           PAGE_SEGMENT_UPDATE_POS(Y);
           PAGE_SEGMENT_UPDATE_POS(Z);
-          PAGE_SEGMENT_UPDATE_POS(E);
+          #if DISABLED(LIN_ADVANCE)
+            PAGE_SEGMENT_UPDATE_POS(E); // Else counted by the eISR
+          #endif
         }
       #endif
       TERN_(HAS_FILAMENT_RUNOUT_DISTANCE, runout.block_completed(current_block));
@@ -1970,13 +2141,7 @@ uint32_t Stepper::block_phase_isr() {
         interval = calc_timer_interval(acc_step_rate, &steps_per_isr);
         acceleration_time += interval;
 
-        #if ENABLED(LIN_ADVANCE)
-          if (LA_use_advance_lead) {
-            // Fire ISR if final adv_rate is reached
-            if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
-          }
-          else if (LA_steps) nextAdvanceISR = 0;
-        #endif
+        TERN_(LIN_ADVANCE, update_advance(acc_step_rate, interval));
 
         // Update laser - Accelerating
         #if ENABLED(LASER_POWER_INLINE_TRAPEZOID)
@@ -2044,16 +2209,7 @@ uint32_t Stepper::block_phase_isr() {
         interval = calc_timer_interval(step_rate, &steps_per_isr);
         deceleration_time += interval;
 
-        #if ENABLED(LIN_ADVANCE)
-          if (LA_use_advance_lead) {
-            // Wake up eISR on first deceleration loop and fire ISR if final adv_rate is reached
-            if (step_events_completed <= decelerate_after + steps_per_isr || (LA_steps && LA_isr_rate != current_block->advance_speed)) {
-              initiateLA();
-              LA_isr_rate = current_block->advance_speed;
-            }
-          }
-          else if (LA_steps) nextAdvanceISR = 0;
-        #endif // LIN_ADVANCE
+        TERN_(LIN_ADVANCE, update_advance(step_rate, interval));
 
         // Update laser - Decelerating
         #if ENABLED(LASER_POWER_INLINE_TRAPEZOID)
@@ -2087,11 +2243,6 @@ uint32_t Stepper::block_phase_isr() {
       // Must be in cruise phase otherwise
       else {
 
-        #if ENABLED(LIN_ADVANCE)
-          // If there are any esteps, fire the next advance_isr "now"
-          if (LA_steps && LA_isr_rate != current_block->advance_speed) initiateLA();
-        #endif
-
         // Calculate the ticks_nominal for this nominal speed, if not done yet
         if (ticks_nominal < 0) {
           // step_rate to timer interval and loops for the nominal speed
@@ -2101,6 +2252,8 @@ uint32_t Stepper::block_phase_isr() {
         // The timer interval is just the nominal value for the nominal speed
         interval = ticks_nominal;
 
+        TERN_(LIN_ADVANCE, update_advance(current_block->nominal_rate, interval));
+
         // Update laser - Cruising
         #if ENABLED(LASER_POWER_INLINE_TRAPEZOID)
           if (laser_trap.enabled) {
@@ -2254,13 +2407,21 @@ uint32_t Stepper::block_phase_isr() {
       // No acceleration / deceleration time elapsed so far
       acceleration_time = deceleration_time = 0;
 
+      // Limit the ISR rates by what the last blocks cost
+      TERN_(ADAPTIVE_MULTI_STEPPING, update_isr_rate_limits());
+
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+        #if ENABLED(ADAPTIVE_MULTI_STEPPING)
+          const uint32_t min_isr_rate = _MIN(isr_rate_limit[0], uint32_t(MIN_STEP_ISR_FREQUENCY)); // Less if over budget
+        #else
+          constexpr uint32_t min_isr_rate = MIN_STEP_ISR_FREQUENCY;
+        #endif
         uint8_t oversampling = 0;                           // Assume no axis smoothing (via oversampling)
         // Decide if axis smoothing is possible
         uint32_t max_rate = current_block->nominal_rate;    // Get the step event rate
-        while (max_rate < MIN_STEP_ISR_FREQUENCY) {         // As long as more ISRs are possible...
+        while (max_rate < min_isr_rate) {                   // As long as more ISRs are possible...
           max_rate <<= 1;                                   // Try to double the rate
-          if (max_rate < MIN_STEP_ISR_FREQUENCY)            // Don't exceed the estimated ISR limit
+          if (max_rate < min_isr_rate)                      // Don't exceed the estimated ISR limit
             ++oversampling;                                 // Increase the oversampling (used for left-shift)
         }
         oversampling_factor = oversampling;                 // For all timer interval calculations
@@ -2271,8 +2432,9 @@ uint32_t Stepper::block_phase_isr() {
       // Based on the oversampling factor, do the calculations
       step_event_count = current_block->step_event_count << oversampling;
 
-      // Initialize Bresenham delta errors to 1/2
+      // Initialize Bresenham delta errors to 1/2. (Assigning a scalar leaves E alone.)
       delta_error = -int32_t(step_event_count);
+      TERN_(HAS_EXTRUDERS, delta_error.e = -int32_t(step_event_count));
 
       // Calculate Bresenham dividends and divisors
       advance_dividend = current_block->steps << 1;
@@ -2295,14 +2457,6 @@ uint32_t Stepper::block_phase_isr() {
           // If the now active extruder wasn't in use during the last move, its pressure is most likely gone.
           if (stepper_extruder != last_moved_extruder) LA_current_adv_steps = 0;
         #endif
-
-        if ((LA_use_advance_lead = current_block->use_advance_lead)) {
-          LA_final_adv_steps = current_block->final_adv_steps;
-          LA_max_adv_steps = current_block->max_adv_steps;
-          initiateLA(); // Start the ISR
-          LA_isr_rate = current_block->advance_speed;
-        }
-        else LA_isr_rate = LA_ADV_NEVER;
       #endif
 
       if ( ENABLED(HAS_L64XX)       // Always set direction for L64xx (Also enables the chips)
@@ -2377,6 +2531,8 @@ uint32_t Stepper::block_phase_isr() {
 
       // Calculate the initial timer interval
       interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
+
+      TERN_(LIN_ADVANCE, update_advance(current_block->initial_rate, interval));
     }
     #if ENABLED(LASER_POWER_INLINE_CONTINUOUS)
       else { // No new block found; so apply inline laser parameters
@@ -2395,32 +2551,55 @@ uint32_t Stepper::block_phase_isr() {
     #endif
   }
 
+  #if ENABLED(LIN_ADVANCE)
+    // Out of moves the nozzle pressure eases off, so take back the advance
+    if (!current_block && LA_current_adv_steps) {
+      LA_target_adv_steps = 0;
+      if (nextAdvanceISR == LA_ADV_NEVER) initiateLA();
+    }
+  #endif
+
   // Return the interval to wait
   return interval;
 }
 
 #if ENABLED(LIN_ADVANCE)
 
+  /**
+   * Set the advance wanted for the given step rate of the current block and
+   * spread the advance steps needed to get there over the coming interval,
+   * no faster than the E jerk speed. Called by the block phase for every new
+   * step rate, so the advance follows the velocity profile as it is run.
+   */
+  void Stepper::update_advance(const uint32_t step_rate, const uint32_t interval) {
+    const uint32_t target = (uint64_t(step_rate) * current_block->la_scale) >> 24;
+    LA_target_adv_steps = _MIN(target, uint32_t(UINT16_MAX));
+
+    const uint16_t diff = LA_target_adv_steps > LA_current_adv_steps
+                        ? LA_target_adv_steps - LA_current_adv_steps
+                        : LA_current_adv_steps - LA_target_adv_steps;
+    if (diff) LA_isr_rate = _MAX(interval / diff, current_block->advance_speed);
+
+    // Start the eISR for advance steps or E steps, unless it's already due
+    if ((diff || LA_steps) && nextAdvanceISR == LA_ADV_NEVER) initiateLA();
+  }
+
   // Timer interrupt for E. LA_steps is set in the main routine
   uint32_t Stepper::advance_isr() {
-    uint32_t interval;
+    uint32_t interval = LA_ADV_NEVER;
 
-    if (LA_use_advance_lead) {
-      if (step_events_completed > decelerate_after && LA_current_adv_steps > LA_final_adv_steps) {
-        LA_steps--;
-        LA_current_adv_steps--;
-        interval = LA_isr_rate;
-      }
-      else if (step_events_completed < decelerate_after && LA_current_adv_steps < LA_max_adv_steps) {
+    // Take one advance step towards the target, and come back if there are more to do
+    if (LA_current_adv_steps != LA_target_adv_steps) {
+      if (LA_current_adv_steps < LA_target_adv_steps) {
         LA_steps++;
         LA_current_adv_steps++;
-        interval = LA_isr_rate;
       }
-      else
-        interval = LA_isr_rate = LA_ADV_NEVER;
+      else {
+        LA_steps--;
+        LA_current_adv_steps--;
+      }
+      if (LA_current_adv_steps != LA_target_adv_steps) interval = LA_isr_rate;
     }
-    else
-      interval = LA_ADV_NEVER;
 
     if (!LA_steps) return interval; // Leave pins alone if there are no steps!
 
@@ -2470,7 +2649,7 @@ uint32_t Stepper::block_phase_isr() {
 
       // Set the STEP pulse ON
       #if ENABLED(MIXING_EXTRUDER)
-        E_STEP_WRITE(mixer.get_next_stepper(), !INVERT_E_STEP_PIN);
+        MIXER_STEP_WRITE(mixer.get_next_steppers(count_direction.e > 0), !INVERT_E_STEP_PIN);
       #else
         E_STEP_WRITE(stepper_extruder, !INVERT_E_STEP_PIN);
       #endif
@@ -2488,7 +2667,7 @@ uint32_t Stepper::block_phase_isr() {
 
       // Set the STEP pulse OFF
       #if ENABLED(MIXING_EXTRUDER)
-        E_STEP_WRITE(mixer.get_stepper(), INVERT_E_STEP_PIN);
+        MIXER_STEP_WRITE(mixer.get_steppers(), INVERT_E_STEP_PIN);
       #else
         E_STEP_WRITE(stepper_extruder, INVERT_E_STEP_PIN);
       #endif
@@ -2869,6 +3048,39 @@ void Stepper::set_axis_position(const AxisEnum a, const int32_t &v) {
   #endif
 }
 
+#if HAS_SHAPING
+
+  void Stepper::set_shaping_params(const AxisEnum axis, const shaping_params_t &params) {
+    planner.synchronize(); // Including the impulses still queued
+
+    const bool was_enabled = suspend();
+
+    // While shaping, the axis DIR follows the shaper instead of the direction bits
+    #define _SET_SHAPING(A, S) do{ \
+      AxisShaper &shaper = input_shaping.S; \
+      if (!shaper.enabled()) shaper.forward = !motor_direction(_AXIS(A)); \
+      shaper.set(params); \
+      if (!shaper.enabled()) { \
+        SET_BIT_TO(last_direction_bits, _AXIS(A), !shaper.forward); \
+        count_direction[_AXIS(A)] = shaper.forward ? 1 : -1; \
+      } \
+    }while(0)
+
+    switch (axis) {
+      #if ENABLED(INPUT_SHAPING_X)
+        case X_AXIS: _SET_SHAPING(X, x); break;
+      #endif
+      #if ENABLED(INPUT_SHAPING_Y)
+        case Y_AXIS: _SET_SHAPING(Y, y); break;
+      #endif
+      default: break;
+    }
+
+    if (was_enabled) wake_up();
+  }
+
+#endif // HAS_SHAPING
+
 // Signal endstops were triggered - This function can be called from
 // an ISR context  (Temperature, Stepper or limits ISR), so we must
 // be very careful here. If the interrupt being preempted was the
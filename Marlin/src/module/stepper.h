@@ -47,6 +47,8 @@
 #include "stepper/indirection.h"
 #ifdef __AVR__
   #include "speed_lookuptable.h"
+#elif ENABLED(STEP_INTERVAL_TABLE)
+  #include "step_interval_table.h"
 #endif
 
 // Disable multiple steps per ISR
@@ -200,12 +202,8 @@
 #if ENABLED(LIN_ADVANCE)
 
   // Estimate the minimum LA loop time
-  #if ENABLED(MIXING_EXTRUDER) // ToDo: ???
-    // HELP ME: What is what?
-    // Directions are set up for MIXING_STEPPERS - like before.
-    // Finding the right stepper may last up to MIXING_STEPPERS loops in get_next_stepper().
-    //   These loops are a bit faster than advancing a bresenham counter.
-    // Always only one e-stepper is stepped.
+  #if ENABLED(MIXING_EXTRUDER)
+    // Each E step advances the DDA of every mixing stepper and may step all of them
     #define MIN_ISR_LA_LOOP_CYCLES ((MIXING_STEPPERS) * (ISR_STEPPER_CYCLES))
   #else
     #define MIN_ISR_LA_LOOP_CYCLES ISR_STEPPER_CYCLES
@@ -372,6 +370,13 @@ class Stepper {
       static constexpr uint8_t oversampling_factor = 0;
     #endif
 
+    #if ENABLED(ADAPTIVE_MULTI_STEPPING)
+      static uint32_t isr_base_cycles,    // Measured ISR cycles besides the step pulses (averaged, x16)
+                      isr_pulse_cycles,   // Measured cycles of the step pulse phase (averaged, x16)
+                      isr_pulse_events,   // Step events done in that pulse phase (averaged, x16)
+                      isr_rate_limit[8];  // ISR rate limit for each multistepping rate, within STEPPER_ISR_BUDGET
+    #endif
+
     // Delta error variables for the Bresenham line tracer
     static xyze_long_t delta_error;
     static xyze_ulong_t advance_dividend;
@@ -402,9 +407,8 @@ class Stepper {
     #if ENABLED(LIN_ADVANCE)
       static constexpr uint32_t LA_ADV_NEVER = 0xFFFFFFFF;
       static uint32_t nextAdvanceISR, LA_isr_rate;
-      static uint16_t LA_current_adv_steps, LA_final_adv_steps, LA_max_adv_steps; // Copy from current executed block. Needed because current_block is set to NULL "too early".
+      static uint16_t LA_current_adv_steps, LA_target_adv_steps; // Advance steps done and wanted for the current step rate
       static int8_t LA_steps;
-      static bool LA_use_advance_lead;
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
@@ -480,6 +484,7 @@ class Stepper {
       // The Linear advance ISR phase
       static uint32_t advance_isr();
       FORCE_INLINE static void initiateLA() { nextAdvanceISR = 0; }
+      static void update_advance(const uint32_t step_rate, const uint32_t interval);
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
@@ -493,6 +498,14 @@ class Stepper {
       }
     #endif
 
+    #if HAS_SHAPING
+      // The input shaping ISR phase
+      static void shaping_isr();
+
+      // Set the input shaping of X or Y, once motion has finished
+      static void set_shaping_params(const AxisEnum axis, const shaping_params_t &params);
+    #endif
+
     // Check if the given block is busy or not - Must not be called from ISR contexts
     static bool is_block_busy(const block_t * const block);
 
@@ -635,6 +648,19 @@ class Stepper {
     // Set the current position in steps
     static void _set_position(const abce_long_t &spos);
 
+    #if ENABLED(ADAPTIVE_MULTI_STEPPING)
+      // Fold one ISR's cycle counts into the averages
+      FORCE_INLINE static void measure_isr(const uint32_t total_cycles, const uint32_t pulse_cycles, const uint32_t pulse_events) {
+        // Follow a rising cost quickly and a falling one slowly
+        #define _ISR_AVERAGE(V, S) do{ const int32_t d = int32_t((S) << 4) - int32_t(V); V += d >> (d > 0 ? 2 : 5); }while(0)
+        _ISR_AVERAGE(isr_base_cycles, total_cycles - pulse_cycles);
+        _ISR_AVERAGE(isr_pulse_cycles, pulse_cycles);
+        _ISR_AVERAGE(isr_pulse_events, pulse_events);
+        #undef _ISR_AVERAGE
+      }
+      static void update_isr_rate_limits();
+    #endif
+
     FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t *loops) {
       uint32_t timer;
 
@@ -644,31 +670,41 @@ class Stepper {
       uint8_t multistep = 1;
       #if DISABLED(DISABLE_MULTI_STEPPING)
 
-        // The stepping frequency limits for each multistepping rate
-        static const uint32_t limit[] PROGMEM = {
-          (  MAX_STEP_ISR_FREQUENCY_1X     ),
-          (  MAX_STEP_ISR_FREQUENCY_2X >> 1),
-          (  MAX_STEP_ISR_FREQUENCY_4X >> 2),
-          (  MAX_STEP_ISR_FREQUENCY_8X >> 3),
-          ( MAX_STEP_ISR_FREQUENCY_16X >> 4),
-          ( MAX_STEP_ISR_FREQUENCY_32X >> 5),
-          ( MAX_STEP_ISR_FREQUENCY_64X >> 6),
-          (MAX_STEP_ISR_FREQUENCY_128X >> 7)
-        };
+        #if ENABLED(ADAPTIVE_MULTI_STEPPING)
+          // The limits measured by update_isr_rate_limits()
+          #define _STEP_RATE_LIMIT(I) isr_rate_limit[I]
+        #else
+          // The stepping frequency limits for each multistepping rate
+          static const uint32_t limit[] PROGMEM = {
+            (  MAX_STEP_ISR_FREQUENCY_1X     ),
+            (  MAX_STEP_ISR_FREQUENCY_2X >> 1),
+            (  MAX_STEP_ISR_FREQUENCY_4X >> 2),
+            (  MAX_STEP_ISR_FREQUENCY_8X >> 3),
+            ( MAX_STEP_ISR_FREQUENCY_16X >> 4),
+            ( MAX_STEP_ISR_FREQUENCY_32X >> 5),
+            ( MAX_STEP_ISR_FREQUENCY_64X >> 6),
+            (MAX_STEP_ISR_FREQUENCY_128X >> 7)
+          };
+          #define _STEP_RATE_LIMIT(I) (uint32_t)pgm_read_dword(&limit[I])
+        #endif
 
         // Select the proper multistepping
         uint8_t idx = 0;
-        while (idx < 7 && step_rate > (uint32_t)pgm_read_dword(&limit[idx])) {
+        while (idx < 7 && step_rate > _STEP_RATE_LIMIT(idx)) {
           step_rate >>= 1;
           multistep <<= 1;
           ++idx;
         };
+        #undef _STEP_RATE_LIMIT
       #else
         NOMORE(step_rate, uint32_t(MAX_STEP_ISR_FREQUENCY_1X));
       #endif
       *loops = multistep;
 
-      #ifdef CPU_32_BIT
+      #if ENABLED(STEP_INTERVAL_TABLE)
+        // Table lookup for processors without a fast divide
+        timer = step_interval(step_rate);
+      #elif defined(CPU_32_BIT)
         // In case of high-performance processor, it is able to calculate in real-time
         timer = uint32_t(STEPPER_TIMER_RATE) / step_rate;
       #else
@@ -931,6 +931,10 @@ void reset_stepper_drivers();    // Called by settings.load / settings.reset
   #define  ENABLE_AXIS_E0() { RREPEAT(MIXING_STEPPERS, _CALL_ENA_E) }
   #define DISABLE_AXIS_E0() { RREPEAT(MIXING_STEPPERS, _CALL_DIS_E) }
 
+  // Step the mixing steppers in a mask from Mixer::get_next_steppers()
+  #define _MIXER_STEP_WRITE(N,M,V) if (TEST(M, N)) E##N##_STEP_WRITE(V);
+  #define MIXER_STEP_WRITE(M,V) do{ const uint8_t _msk = (M); RREPEAT2(MIXING_STEPPERS, _MIXER_STEP_WRITE, _msk, V) }while(0)
+
 #elif ENABLED(E_DUAL_STEPPER_DRIVERS)
 
   #define  ENABLE_AXIS_E0() do{  ENABLE_STEPPER_E0();  ENABLE_STEPPER_E1(); }while(0)
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""
+Read the binary GPIO trace written by the LINUX HAL (IOLoggerBinary).
+
+  gpio_trace.py all_gpio_log.bin                 summary per pin
+  gpio_trace.py all_gpio_log.bin csv [-o out]    convert to "timestamp, pin, event" CSV
+  gpio_trace.py all_gpio_log.bin dump --pin 54   human readable listing
+
+Records are stored in the order slots were claimed, which can differ from
+timestamp order when several threads log at once, so output is sorted.
+"""
+
+import argparse, struct, sys
+
+HEADER = struct.Struct('<4sHHIIQQ')
+RECORD = struct.Struct('<QhBBHH')
+EVENTS = ['NOP', 'FALL', 'RISE', 'SET_VALUE', 'SETM', 'SETD']
+
+def read_trace(path):
+    with open(path, 'rb') as f:
+        magic, version, record_size, freq, _, count, dropped = HEADER.unpack(f.read(HEADER.size))
+        if magic != b'MGPT':
+            sys.exit("%s: not a GPIO trace" % path)
+        if version != 1 or record_size != RECORD.size:
+            sys.exit("%s: unsupported trace version %d (record size %d)" % (path, version, record_size))
+        data = f.read(count * record_size)
+    records = sorted(RECORD.iter_unpack(data[:len(data) - len(data) % record_size]), key=lambda r: r[0])
+    return freq, dropped, records
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('trace')
+    parser.add_argument('command', nargs='?', default='stats', choices=['stats', 'csv', 'dump'])
+    parser.add_argument('--pin', type=int, action='append', help='only this pin (repeatable)')
+    parser.add_argument('-o', '--output', help='output file (default stdout)')
+    args = parser.parse_args()
+
+    freq, dropped, records = read_trace(args.trace)
+    if args.pin:
+        records = [r for r in records if r[1] in args.pin]
+    out = open(args.output, 'w') if args.output else sys.stdout
+
+    if args.command == 'csv':
+        # Same columns as the old IOLoggerCSV output
+        for ts, pin, event, _, value, _ in records:
+            out.write("%d, %d, %d\n" % (ts, pin, event))
+    elif args.command == 'dump':
+        for ts, pin, event, _, value, _ in records:
+            out.write("%14.6f ms  pin %3d  %-9s  %d\n" % (ts / 1e6, pin, EVENTS[event] if event < len(EVENTS) else event, value))
+    else:
+        pins = {}
+        for ts, pin, event, _, value, _ in records:
+            p = pins.setdefault(pin, [0] * len(EVENTS) + [ts, ts])
+            if event < len(EVENTS): p[event] += 1
+            p[-1] = ts
+        out.write("%d events, %d dropped, CPU clock %d Hz\n" % (len(records), dropped, freq))
+        if records:
+            out.write("span %.6f s\n" % ((records[-1][0] - records[0][0]) / 1e9))
+        out.write("%5s %10s %10s %10s %8s %8s\n" % ('pin', 'rise', 'fall', 'value', 'mode', 'dir'))
+        for pin in sorted(pins):
+            p = pins[pin]
+            out.write("%5d %10d %10d %10d %8d %8d\n" % (pin, p[2], p[1], p[3], p[4], p[5]))
+
+if __name__ == '__main__':
+    main()